@@ -0,0 +1,47 @@
+#ifndef LARGE_VOLUME_TRADING_BENCH_DATA_H_
+#define LARGE_VOLUME_TRADING_BENCH_DATA_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "market/market_data_columns.h"
+#include "market/timestamp.h"
+
+namespace lvt {
+
+// Deterministic minute bars with a wandering price and uneven volume.
+inline MarketDataColumns MakeBenchBars(size_t n) {
+  MarketDataColumns bars;
+  bars.Reserve(n);
+  uint64_t state = 88172645463325252ull;
+  double price = 100.0;
+  for (size_t i = 0; i < n; ++i) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    price += ((state & 0xff) - 127.5) * 1e-3;
+    bars.Append(static_cast<int64_t>(i) * kNanosPerMinute, price, 100.0 + (state >> 40) % 5000);
+  }
+  return bars;
+}
+
+// The same bars as CSV text in the input format.
+inline std::string MakeBenchCsv(size_t n) {
+  const MarketDataColumns bars = MakeBenchBars(n);
+  std::string csv = "timestamp,price,volume\n";
+  csv.reserve(n * 48);
+  char stamp[kMaxTimestampLength];
+  for (size_t i = 0; i < n; ++i) {
+    csv.append(stamp, FormatTimestamp(bars.epoch_ns()[i], stamp));
+    csv += ',';
+    csv += std::to_string(bars.price()[i]);
+    csv += ',';
+    csv += std::to_string(static_cast<int64_t>(bars.volume()[i]));
+    csv += '\n';
+  }
+  return csv;
+}
+
+}  // namespace lvt
+
+#endif  // LARGE_VOLUME_TRADING_BENCH_DATA_H_
@@ -0,0 +1,54 @@
+#include <benchmark/benchmark.h>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include "bench_data.h"
+#include "market/csv_parser.h"
+#include "market/market_simulator.h"
+
+namespace lvt {
+namespace {
+
+// In-memory CSV parsing; bytes/s is the parser's MB/s.
+void BM_CsvParse(benchmark::State& state) {
+  const std::string csv = MakeBenchCsv(state.range(0));
+  MarketDataColumns out;
+  out.Reserve(state.range(0));
+  for (auto _ : state) {
+    MarketDataCsvParser parser;
+    out.Clear();
+    parser.Parse(csv, &out);
+    benchmark::DoNotOptimize(out.price().data());
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * csv.size());
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_CsvParse)->Arg(10000)->Arg(1000000)->Unit(benchmark::kMillisecond);
+
+// MarketSimulator::Load from a file, per LoadMode (0 stream, 1 mmap,
+// 2 cached). Includes file I/O and the trading day index.
+void BM_SimulatorLoad(benchmark::State& state) {
+  const LoadMode modes[] = {LoadMode::kStream, LoadMode::kMmap, LoadMode::kCached};
+  const char* names[] = {"stream", "mmap", "cached"};
+  const LoadMode mode = modes[state.range(0)];
+  const auto path = std::filesystem::temp_directory_path() / "lvt_bench_load.csv";
+  {
+    std::ofstream file(path, std::ios::binary);
+    file << MakeBenchCsv(1000000);
+  }
+  const auto bytes = std::filesystem::file_size(path);
+  if (mode == LoadMode::kCached) MarketSimulator(path.string()).Load(mode);  // Build the cache.
+  for (auto _ : state) {
+    MarketSimulator sim(path.string());
+    if (!sim.Load(mode)) state.SkipWithError("load failed");
+    benchmark::DoNotOptimize(sim.GetMarketData().size());
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * bytes);
+  state.SetLabel(names[state.range(0)]);
+  std::filesystem::remove(path);
+  std::filesystem::remove(path.string() + ".lvtc");
+}
+BENCHMARK(BM_SimulatorLoad)->DenseRange(0, 2)->Unit(benchmark::kMillisecond);
+
+}  // namespace
+}  // namespace lvt
@@ -0,0 +1,61 @@
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <vector>
+#include "bench_data.h"
+#include "order/fill_simulator.h"
+#include "order/order_manager.h"
+
+namespace lvt {
+namespace {
+
+constexpr size_t kLogSize = 1 << 20;
+
+// IssueOrder into a reserved log; the log is cleared when full, so the
+// steady state never allocates.
+void BM_IssueOrder(benchmark::State& state) {
+  OrderManager orders;
+  orders.Reserve(kLogSize);
+  int64_t t = 0;
+  for (auto _ : state) {
+    if (orders.size() == kLogSize) orders.Clear();
+    benchmark::DoNotOptimize(orders.IssueOrder(1.0, 100.0, ++t));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_IssueOrder);
+
+// SubmitOrder through the lock-free ring, drained in batches of the
+// benchmark argument.
+void BM_SubmitAndDrain(benchmark::State& state) {
+  const size_t batch = static_cast<size_t>(state.range(0));
+  OrderManager orders(batch);
+  orders.Reserve(kLogSize);
+  int64_t t = 0;
+  for (auto _ : state) {
+    for (size_t i = 0; i < batch; ++i) orders.SubmitOrder(1.0, 100.0, ++t);
+    orders.DrainSubmissions();
+    if (orders.size() + batch > kLogSize) orders.Clear();
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * batch);
+}
+BENCHMARK(BM_SubmitAndDrain)->Arg(64)->Arg(4096);
+
+// Whole-schedule fill pass with a binding cap and impact; items are bars.
+void BM_FillSimulate(benchmark::State& state) {
+  const MarketDataColumns bars = MakeBenchBars(state.range(0));
+  std::vector<double> schedule(bars.size(), 100.0), fills(bars.size()), prices(bars.size());
+  FillModel model;
+  model.eta = 1e-4;
+  model.gamma = 1e-7;
+  model.max_participation = 0.1;
+  const FillSimulator sim(model);
+  for (auto _ : state) {
+    sim.Simulate(bars, schedule, fills, prices);
+    benchmark::DoNotOptimize(prices.data());
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_FillSimulate)->RangeMultiplier(100)->Range(100, 1000000)->Unit(benchmark::kMicrosecond);
+
+}  // namespace
+}  // namespace lvt
@@ -0,0 +1,70 @@
+#include <benchmark/benchmark.h>
+#include "bench_data.h"
+#include "strategy/almgren_kriss_model.h"
+#include "strategy/incremental_vwap.h"
+#include "strategy/limit_order_speed_model.h"
+#include "strategy/vwap_calculator.h"
+
+namespace lvt {
+namespace {
+
+// Schedule sizes from 10^2 to 10^7 intervals.
+void ScheduleSizes(benchmark::internal::Benchmark* b) {
+  b->RangeMultiplier(10)->Range(100, 10000000)->Unit(benchmark::kMicrosecond);
+}
+
+void BM_VWAPSchedule(benchmark::State& state) {
+  const MarketDataColumns bars = MakeBenchBars(state.range(0));
+  VWAPCalculator vwap;
+  vwap.SetMarketData(bars);
+  for (auto _ : state) {
+    vwap.ComputeVWAPSchedule(1e6);
+    benchmark::DoNotOptimize(vwap.GetSchedule().data());
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_VWAPSchedule)->Apply(ScheduleSizes);
+
+// Capacity-limited allocation: the participation cap binds on thin bars.
+void BM_OptimalSpeedSchedule(benchmark::State& state) {
+  const MarketDataColumns bars = MakeBenchBars(state.range(0));
+  LimitOrderSpeedModel model;
+  model.SetMarketData(bars);
+  const double total = 20.0 * state.range(0);
+  for (auto _ : state) {
+    model.ComputeOptimalSpeedSchedule(total, 0, 0.0, 0.01);
+    benchmark::DoNotOptimize(model.GetSchedule().data());
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_OptimalSpeedSchedule)->Apply(ScheduleSizes);
+
+void BM_AlmgrenKrissSchedule(benchmark::State& state) {
+  const MarketDataColumns bars = MakeBenchBars(state.range(0));
+  AlmgrenKrissModel ak;
+  ak.SetParameters(1.0, 0.01, 0.5, 1e-6);
+  ak.SetMarketData(bars.price(), 1e6);
+  for (auto _ : state) {
+    ak.ComputeOptimalSchedule();
+    benchmark::DoNotOptimize(ak.GetSchedule().data());
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_AlmgrenKrissSchedule)->Apply(ScheduleSizes);
+
+// Bar-by-bar VWAP re-planning; items are bars.
+void BM_IncrementalVWAP(benchmark::State& state) {
+  const MarketDataColumns bars = MakeBenchBars(state.range(0));
+  IncrementalVWAP vwap;
+  for (auto _ : state) {
+    vwap.Start(bars.volume(), 1e6);
+    double traded = 0.0;
+    for (size_t i = 0; i < bars.size(); ++i) traded += vwap.OnBar(bars.Row(i));
+    benchmark::DoNotOptimize(traded);
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_IncrementalVWAP)->Apply(ScheduleSizes);
+
+}  // namespace
+}  // namespace lvt
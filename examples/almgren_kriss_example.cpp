@@ -29,18 +29,8 @@ int main(int argc, char* argv[]) {
   const auto& all_data = sim.GetMarketData();
   std::cout << "[Log] Loaded " << all_data.size() << " prices." << std::endl;
 
-  // Filter to first day only (extract date from first timestamp, use until date changes)
-  std::vector<double> prices;
-  if (!all_data.empty()) {
-    std::string first_date = all_data[0].timestamp.substr(0, 10);
-    for (const auto& d : all_data) {
-      if (d.timestamp.substr(0, 10) == first_date) {
-        prices.push_back(d.price);
-      } else {
-        break;
-      }
-    }
-  }
+  // First trading day only, looked up in the day index built at load time
+  const auto prices = sim.GetFirstSession().price();
   std::cout << "[Log] Using first day: " << prices.size() << " intervals." << std::endl;
   lvt::AlmgrenKrissModel ak;
   ak.SetMarketData(prices, total_volume);
@@ -33,9 +33,9 @@ int main(int argc, char* argv[]) {
   std::cout << "timestamp,market_price,market_volume,trade_volume" << std::endl;
   double sum_trade = 0, vwap_pv = 0, vwap_nv = 0;
   for (size_t i = 0; i < schedule.size(); ++i) {
-    std::cout << data[i].timestamp << "," << data[i].price << "," << data[i].volume << "," << schedule[i] << std::endl;
+    std::cout << data.Timestamp(i) << "," << data.price()[i] << "," << data.volume()[i] << "," << schedule[i] << std::endl;
     sum_trade += schedule[i];
-    vwap_pv += data[i].price * schedule[i];
+    vwap_pv += data.price()[i] * schedule[i];
     vwap_nv += schedule[i];
   }
   std::cout << std::fixed << std::setprecision(4);
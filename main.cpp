@@ -1,12 +1,29 @@
+#include <cmath>
 #include <iostream>
 #include <string>
 #include <vector>
 #include <fstream>
 #include <map>
+#include <memory>
+#include <set>
+#include <span>
+#include "engine/backtest_engine.h"
+#include "engine/batch_runner.h"
+#include "engine/monte_carlo_engine.h"
+#include "engine/schedule_writer.h"
+#include "market/market_data_reader.h"
 #include "market/market_simulator.h"
+#include "market/timestamp.h"
+#include "market/volume_profile.h"
+#include "order/order_manager.h"
 #include "strategy/vwap_calculator.h"
 #include "strategy/limit_order_speed_model.h"
 #include "strategy/almgren_kriss_model.h"
+#include "strategy/market_calibrator.h"
+#include "strategy/parameter_sweep.h"
+#include "util/background_writer.h"
+#include "util/instrumentation.h"
+#include "util/thread_pool.h"
 
 void PrintUsage(const char* prog_name) {
   std::cerr << "Usage: " << prog_name
@@ -14,25 +31,203 @@ void PrintUsage(const char* prog_name) {
             << " --input <csv_file>"
             << " --total_volume <volume>"
             << " [--output <output_file>]"
+            << " [--mmap] (memory-map the input file)"
+            << " [--cache] (reuse/refresh a binary <input>.lvtc cache)"
+            << " [--stream] (VWAP only: two streaming passes in bounded memory)"
+            << " [--backtest] (replay the bars and write the executions instead of the schedule)"
+            << " [--impact_eta <eta>] [--impact_gamma <gamma>] [--max_participation <fraction>]"
+            << " (backtest fill model; --max_participation also caps OptimalSpeed)"
+            << " [--monte_carlo <paths>] [--seed <n>] (write the schedule's cost distribution instead;"
+            << " uses --eta/--gamma and --sigma, or the calibrated or bars' volatility without --sigma)"
+            << " [--save_profile <file>] (save the average intraday volume curve of the input)"
+            << " [--profile <file> --session_start <time> --session_end <time>]"
+            << " (VWAP only: schedule a future session from a saved profile; no --input needed)"
             << " [--intervals <N>] (for OptimalSpeed)"
             << " [--max_speed <speed>] (for OptimalSpeed)"
-            << " [--eta <eta>] [--gamma <gamma>] [--sigma <sigma>] [--lambda <lambda>] (for AlmgrenKriss)\n";
+            << " [--eta <eta>] [--gamma <gamma>] [--sigma <sigma>] [--lambda <lambda>] (for AlmgrenKriss)"
+            << " [--calibrated] (default eta/gamma/sigma estimated from the input bars)"
+            << " [--stats] (per-stage counts, totals and p50/p99/p999 latencies to stderr)"
+            << " [--output_format <csv|binary>] [--async_output] (schedule/execution output encoding;"
+            << " write it from a background thread)"
+            << " [--start_date <YYYY-MM-DD>] [--end_date <YYYY-MM-DD>] (AlmgrenKriss over several sessions)"
+            << " [--sweep] (AlmgrenKriss: comma-separated --eta/--gamma/--sigma/--lambda lists, evaluated as a grid)"
+            << " [--sweep_file <csv>] (AlmgrenKriss: one eta,gamma,sigma,lambda set per line)\n"
+            << "       " << prog_name
+            << " --batch <manifest> [--output_dir <dir>] [--threads <N>] [--output <summary_file>]"
+            << " [--mmap] [--cache] [--stats] [--output_format <csv|binary>] [--async_output]\n"
+            << "       " << prog_name << " --calibrate <file>[,<file>...] [--threads <N>] [--output <file>]\n";
+}
+
+// Writes the stage timings collected during the run to stderr.
+void WriteStats() {
+  std::cerr << "[Log] Stage statistics:\n";
+  lvt::WriteStageStats(std::cerr);
+}
+
+// Replays `bars` with `schedule` as the child orders (slice i in bar i) and
+// writes the resulting executions; a summary goes to stderr.
+bool WriteBacktest(lvt::MarketDataView bars, std::span<const double> schedule,
+                   const lvt::FillModel& fill_model, lvt::ScheduleWriter* writer) {
+  lvt::ScheduleStrategy strategy(schedule);
+  lvt::OrderManager orders;
+  lvt::BacktestEngine engine(fill_model);
+  lvt::BacktestReport report;
+  if (!engine.Run(bars, &strategy, &orders, &report)) return false;
+  writer->BeginExecutions();
+  writer->AppendExecutions(orders.GetExecutions());
+  std::cerr << "[Log] Backtest: " << report.bars << " bars, " << report.orders << " orders, filled "
+            << report.filled_volume << " at " << report.average_price << " vs market VWAP "
+            << report.market_vwap << " (" << report.slippage_bps << " bps), impact cost "
+            << report.impact_cost << ", unfilled " << report.unfilled_volume << "\n";
+  return true;
+}
+
+// Simulates the cost distribution of `schedule` and writes it as a
+// statistic,value table. A negative config.sigma is replaced by the per-bar
+// volatility `bar_sigma`, rescaled from bars to schedule intervals; a
+// negative `bar_sigma` is estimated from `bars` (MarketCalibrator, which
+// skips overnight gaps).
+bool WriteCostDistribution(lvt::MarketDataView bars, std::span<const double> schedule,
+                           lvt::MonteCarloConfig config, double bar_sigma, std::ostream& out) {
+  if (config.sigma < 0 && !schedule.empty()) {
+    if (bar_sigma < 0) {
+      lvt::MarketCalibrator calibrator;
+      calibrator.Add(bars);
+      bar_sigma = calibrator.Result().sigma;
+    }
+    config.sigma = bar_sigma * std::sqrt(static_cast<double>(bars.size()) / schedule.size());
+  }
+  lvt::ThreadPool pool;
+  lvt::MonteCarloCostEngine engine(config);
+  lvt::CostDistribution result;
+  if (!engine.Evaluate(schedule, &pool, &result)) return false;
+  out << "statistic,value\n";
+  out << "paths," << result.paths << "\n";
+  out << "sigma," << config.sigma << "\n";
+  out << "mean," << result.mean << "\n";
+  out << "variance," << result.variance << "\n";
+  for (size_t i = 0; i < result.quantiles.size(); ++i) {
+    out << "q" << config.quantiles[i] * 100 << "," << result.quantiles[i] << "\n";
+  }
+  return true;
 }
 
 int main(int argc, char* argv[]) {
   std::map<std::string, std::string> args;
-  for (int i = 1; i < argc; i += 2) {
-    if (i + 1 < argc) {
+  // Boolean switches take no value; everything else is a "--key value" pair.
+  const std::set<std::string> flags = {"--mmap", "--cache", "--stream", "--sweep", "--backtest",
+                                        "--calibrated", "--stats", "--async_output"};
+  for (int i = 1; i < argc; ++i) {
+    if (flags.count(argv[i])) {
+      args[argv[i]] = "1";
+    } else if (i + 1 < argc) {
       args[argv[i]] = argv[i + 1];
+      ++i;
     } else {
       std::cerr << "Error: Missing value for argument: " << argv[i] << "\n";
       PrintUsage(argv[0]);
       return 1;
     }
   }
+  const bool stats = args.count("--stats") > 0;
+  if (stats) {
+#ifdef LVT_ENABLE_INSTRUMENTATION
+    lvt::SetStageTimingEnabled(true);
+#else
+    std::cerr << "[Warning] --stats needs a build with LVT_INSTRUMENTATION=ON; no stages are timed\n";
+#endif
+  }
+
+  lvt::OutputFormat output_format = lvt::OutputFormat::kCsv;
+  if (args.count("--output_format") && !lvt::ParseOutputFormat(args["--output_format"], &output_format)) {
+    std::cerr << "Error: Invalid output_format value: " << args["--output_format"] << "\n";
+    return 1;
+  }
+  // Cost distributions and sweep results are small CSV tables written
+  // directly to the output stream, not through ScheduleWriter.
+  if ((args.count("--monte_carlo") || args.count("--sweep") || args.count("--sweep_file")) &&
+      (output_format != lvt::OutputFormat::kCsv || args.count("--async_output"))) {
+    std::cerr << "Error: --output_format binary and --async_output do not apply to --monte_carlo "
+                 "or a parameter sweep\n";
+    return 1;
+  }
+  // Declared before the background writer so the file outlives any queued
+  // writes to it.
+  std::unique_ptr<std::ofstream> output_file;
+  // Formatted blocks go to this thread, so writing overlaps the computation.
+  std::unique_ptr<lvt::BackgroundWriter> background;
+  if (args.count("--async_output")) background = std::make_unique<lvt::BackgroundWriter>();
+
+  if (args.count("--batch")) {
+    // Batch mode: every manifest row is an independent order with its own output.
+    lvt::LoadMode batch_mode = args.count("--cache") ? lvt::LoadMode::kCached
+                               : args.count("--mmap") ? lvt::LoadMode::kMmap
+                                                      : lvt::LoadMode::kStream;
+    size_t threads = 0;
+    try {
+      if (args.count("--threads")) threads = std::stoul(args["--threads"]);
+    } catch (const std::exception& e) {
+      std::cerr << "Error: Invalid threads value: " << args["--threads"] << "\n";
+      return 1;
+    }
+    const std::string output_dir = args.count("--output_dir") ? args["--output_dir"] : ".";
+    std::vector<lvt::BatchJob> jobs;
+    if (!lvt::LoadBatchManifest(args["--batch"], output_dir, &jobs,
+                                lvt::OutputExtension(output_format))) {
+      return 1;
+    }
+    lvt::ThreadPool pool(threads);
+    lvt::BatchRunner runner(batch_mode, output_format, background.get());
+    bool ok = runner.Run(jobs, &pool);
+    if (stats) WriteStats();
+    if (args.count("--output")) {
+      std::ofstream summary(args["--output"]);
+      if (!summary.is_open()) {
+        std::cerr << "Failed to open output file: " << args["--output"] << "\n";
+        return 1;
+      }
+      runner.WriteTimingSummary(summary);
+    } else {
+      runner.WriteTimingSummary(std::cout);
+    }
+    return ok ? 0 : 1;
+  }
+
+  if (args.count("--calibrate")) {
+    // Calibration mode: one streaming pass per file, files in parallel.
+    std::vector<std::string> paths;
+    std::string list = args["--calibrate"];
+    for (size_t begin = 0; begin <= list.size();) {
+      size_t end = list.find(',', begin);
+      if (end == std::string::npos) end = list.size();
+      if (end > begin) paths.push_back(list.substr(begin, end - begin));
+      begin = end + 1;
+    }
+    size_t threads = 0;
+    try {
+      if (args.count("--threads")) threads = std::stoul(args["--threads"]);
+    } catch (const std::exception& e) {
+      std::cerr << "Error: Invalid threads value: " << args["--threads"] << "\n";
+      return 1;
+    }
+    lvt::ThreadPool pool(threads);
+    std::vector<lvt::CalibrationResult> results;
+    if (!lvt::CalibrateFiles(paths, &pool, &results)) return 1;
+    if (args.count("--output")) {
+      std::ofstream out(args["--output"]);
+      if (!out.is_open()) {
+        std::cerr << "Failed to open output file: " << args["--output"] << "\n";
+        return 1;
+      }
+      lvt::WriteCalibration(paths, results, out);
+    } else {
+      lvt::WriteCalibration(paths, results, std::cout);
+    }
+    return 0;
+  }
 
   if (args.find("--strategy") == args.end() ||
-      args.find("--input") == args.end() ||
+      (args.find("--input") == args.end() && args.find("--profile") == args.end()) ||
       args.find("--total_volume") == args.end()) {
     PrintUsage(argv[0]);
     return 1;
@@ -47,19 +242,165 @@ int main(int argc, char* argv[]) {
     std::cerr << "Error: Invalid total_volume value: " << args["--total_volume"] << "\n";
     return 1;
   }
-  bool has_output = args.find("--output") != args.end();
-  std::ostream* out_stream = has_output ? 
-    new std::ofstream(args["--output"]) : &std::cout;
-
-  if (has_output && !static_cast<std::ofstream*>(out_stream)->is_open()) {
-    std::cerr << "Failed to open output file: " << args["--output"] << "\n";
+  if (args.find("--output") != args.end()) {
+    output_file = std::make_unique<std::ofstream>(
+        args["--output"], output_format == lvt::OutputFormat::kBinary ? std::ios::out | std::ios::binary
+                                                                       : std::ios::out);
+    if (!output_file->is_open()) {
+      std::cerr << "Failed to open output file: " << args["--output"] << "\n";
+      return 1;
+    }
+  }
+  std::ostream* out_stream = output_file ? output_file.get() : &std::cout;
+  lvt::ScheduleWriter writer(output_format, background.get());
+  writer.Open(out_stream);
+  // Completes the buffered (and queued) output; the stream must outlive it.
+  auto finish_output = [&] {
+    bool ok = writer.Finish();
+    if (background) ok = background->Drain() && ok;
+    if (!ok) std::cerr << "Failed to write output\n";
+    return ok;
+  };
+  // Error exit once the output is open: completes what was written so far.
+  auto fail = [&] {
+    finish_output();
     return 1;
+  };
+
+  if (args.count("--profile")) {
+    // Forward-looking VWAP from a saved volume profile; no market data is loaded.
+    if (strategy != "VWAP") {
+      std::cerr << "Error: --profile is only supported for the VWAP strategy\n";
+      return fail();
+    }
+    lvt::VolumeProfile profile;
+    if (!profile.Load(args["--profile"])) {
+      std::cerr << "Failed to load volume profile from " << args["--profile"] << "\n";
+      return fail();
+    }
+    int64_t session_start = 0;
+    int64_t session_end = 0;
+    if (!args.count("--session_start") || !args.count("--session_end") ||
+        !lvt::ParseTimestamp(args["--session_start"], &session_start) ||
+        !lvt::ParseTimestamp(args["--session_end"], &session_end)) {
+      std::cerr << "Error: --profile needs valid --session_start and --session_end timestamps\n";
+      return fail();
+    }
+    lvt::VWAPCalculator vwap;
+    vwap.ComputeProfileSchedule(profile, session_start, session_end, total_volume);
+    const auto& schedule = vwap.GetSchedule();
+    const int64_t first_minute = lvt::FloorToMinute(session_start);
+    std::vector<int64_t> minutes(schedule.size());
+    for (size_t i = 0; i < minutes.size(); ++i) {
+      minutes[i] = first_minute + static_cast<int64_t>(i) * lvt::kNanosPerMinute;
+    }
+    writer.BeginTimestampSchedule();
+    writer.AppendTimestampSchedule(minutes, schedule);
+    return finish_output() ? 0 : 1;
+  }
+
+  if (args.count("--stream")) {
+    if (strategy != "VWAP") {
+      std::cerr << "Error: --stream is only supported for the VWAP strategy\n";
+      return fail();
+    }
+    lvt::MarketDataReader reader(csv_file);
+    writer.BeginTimestampSchedule();
+    bool ok = lvt::VWAPCalculator::ComputeVWAPScheduleStreaming(
+        &reader, total_volume, [&](lvt::MarketDataView bars, std::span<const double> schedule) {
+          writer.AppendTimestampSchedule(bars.epoch_ns(), schedule);
+        });
+    const bool written = finish_output();
+    if (!ok) {
+      std::cerr << "Failed to stream market data from " << csv_file << "\n";
+      return 1;
+    }
+    return written ? 0 : 1;
   }
 
   lvt::MarketSimulator sim(csv_file);
-  if (!sim.Load()) {
+  lvt::LoadMode load_mode = lvt::LoadMode::kStream;
+  if (args.count("--cache")) {
+    load_mode = lvt::LoadMode::kCached;
+  } else if (args.count("--mmap")) {
+    load_mode = lvt::LoadMode::kMmap;
+  }
+  if (!sim.Load(load_mode)) {
     std::cerr << "Failed to load market data from " << csv_file << "\n";
-    return 1;
+    return fail();
+  }
+
+  const bool backtest = args.count("--backtest") > 0;
+  if (backtest && (args.count("--sweep") || args.count("--sweep_file"))) {
+    std::cerr << "Error: --backtest cannot be combined with a parameter sweep\n";
+    return fail();
+  }
+  // Model defaults; --calibrated replaces them with estimates from the bars.
+  lvt::AlmgrenKrissParams model_defaults;
+  if (args.count("--calibrated")) {
+    lvt::MarketCalibrator calibrator;
+    calibrator.Add(sim.GetMarketData());
+    const lvt::CalibrationResult calibration = calibrator.Result();
+    model_defaults = calibration.ToParameters(model_defaults.lambda);
+    std::cerr << "[Log] Calibrated from " << calibration.bars << " bars over " << calibration.days
+              << " days: sigma=" << model_defaults.sigma << " spread=" << calibration.spread()
+              << " eta=" << model_defaults.eta << " gamma=" << model_defaults.gamma << "\n";
+  }
+
+  const bool monte_carlo = args.count("--monte_carlo") > 0;
+  if (monte_carlo && (backtest || args.count("--sweep") || args.count("--sweep_file"))) {
+    std::cerr << "Error: --monte_carlo cannot be combined with --backtest or a parameter sweep\n";
+    return fail();
+  }
+  lvt::MonteCarloConfig mc_config;
+  // Per-bar sigma behind mc_config.sigma when --sigma is not given: the
+  // calibrated one, or estimated from the scheduled bars (-1).
+  const double mc_bar_sigma = args.count("--calibrated") ? model_defaults.sigma : -1.0;
+  if (monte_carlo) {
+    long long paths = 0;
+    try {
+      paths = std::stoll(args["--monte_carlo"]);
+    } catch (const std::exception& e) {
+      std::cerr << "Error: Invalid monte_carlo value: " << args["--monte_carlo"] << "\n";
+      return fail();
+    }
+    if (paths <= 0) {
+      std::cerr << "Error: --monte_carlo needs a positive number of paths\n";
+      return fail();
+    }
+    mc_config.paths = static_cast<size_t>(paths);
+    mc_config.eta = model_defaults.eta;
+    mc_config.gamma = model_defaults.gamma;
+    try {
+      if (args.count("--seed")) mc_config.seed = std::stoull(args["--seed"]);
+      if (args.count("--eta")) mc_config.eta = std::stod(args["--eta"]);
+      if (args.count("--gamma")) mc_config.gamma = std::stod(args["--gamma"]);
+      mc_config.sigma = args.count("--sigma") ? std::stod(args["--sigma"]) : -1.0;
+    } catch (const std::exception& e) {
+      std::cerr << "Error: Invalid parameter value for --monte_carlo\n";
+      return fail();
+    }
+  }
+  lvt::FillModel fill_model;
+  try {
+    if (args.count("--impact_eta")) fill_model.eta = std::stod(args["--impact_eta"]);
+    if (args.count("--impact_gamma")) fill_model.gamma = std::stod(args["--impact_gamma"]);
+    if (args.count("--max_participation")) {
+      fill_model.max_participation = std::stod(args["--max_participation"]);
+    }
+  } catch (const std::exception& e) {
+    std::cerr << "Error: Invalid fill model value for --impact_eta/--impact_gamma/--max_participation\n";
+    return fail();
+  }
+
+  if (args.count("--save_profile")) {
+    lvt::ThreadPool pool;
+    lvt::VolumeProfile profile;
+    if (!profile.Build(sim.GetMarketData(), sim.GetDayIndex(), &pool) ||
+        !profile.Save(args["--save_profile"])) {
+      std::cerr << "Failed to write volume profile to " << args["--save_profile"] << "\n";
+      return fail();
+    }
   }
 
   if (strategy == "VWAP") {
@@ -69,9 +410,14 @@ int main(int argc, char* argv[]) {
     const auto& schedule = vwap.GetSchedule();
     const auto& data = sim.GetMarketData();
 
-    *out_stream << "timestamp,trade_volume\n";
-    for (size_t i = 0; i < schedule.size(); ++i) {
-      *out_stream << data[i].timestamp << "," << schedule[i] << "\n";
+    if (backtest) {
+      if (!WriteBacktest(data, schedule, fill_model, &writer)) return fail();
+    } else if (monte_carlo) {
+      if (!WriteCostDistribution(data, schedule, mc_config, mc_bar_sigma, *out_stream)) return fail();
+    } else {
+      LVT_STAGE_TIMER(lvt::Stage::kOutput);
+      writer.BeginTimestampSchedule();
+      writer.AppendTimestampSchedule(data.epoch_ns(), schedule);
     }
   } else if (strategy == "OptimalSpeed") {
     int intervals = args.find("--intervals") != args.end() ?
@@ -82,62 +428,151 @@ int main(int argc, char* argv[]) {
         max_speed = std::stod(args["--max_speed"]);
       } catch (const std::exception& e) {
         std::cerr << "Error: Invalid max_speed value: " << args["--max_speed"] << "\n";
-        return 1;
+        return fail();
       }
     }
 
     lvt::LimitOrderSpeedModel speed_model;
     speed_model.SetMarketData(sim.GetMarketData());
-    speed_model.ComputeOptimalSpeedSchedule(total_volume, intervals, max_speed);
+    // The participation cap that limits backtest fills also bounds the plan.
+    speed_model.ComputeOptimalSpeedSchedule(total_volume, intervals, max_speed,
+                                            fill_model.max_participation);
     const auto& schedule = speed_model.GetSchedule();
+    if (speed_model.GetUnfilledVolume() > 0) {
+      std::cerr << "[Warning] " << speed_model.GetUnfilledVolume()
+                << " of the volume does not fit within --max_speed/--max_participation\n";
+    }
 
-    *out_stream << "interval,trade_volume\n";
-    for (size_t i = 0; i < schedule.size(); ++i) {
-      *out_stream << i << "," << schedule[i] << "\n";
+    if (backtest) {
+      if (!WriteBacktest(sim.GetMarketData(), schedule, fill_model, &writer)) return fail();
+    } else if (monte_carlo) {
+      if (!WriteCostDistribution(sim.GetMarketData(), schedule, mc_config, mc_bar_sigma, *out_stream)) {
+        return fail();
+      }
+    } else {
+      LVT_STAGE_TIMER(lvt::Stage::kOutput);
+      writer.BeginIntervalSchedule();
+      writer.AppendIntervalSchedule(schedule);
     }
   } else if (strategy == "AlmgrenKriss") {
-    double eta = 1.0, gamma = 0.01, sigma = 0.5, lambda = 1.0;
-    try {
-      if (args.find("--eta") != args.end()) eta = std::stod(args["--eta"]);
-      if (args.find("--gamma") != args.end()) gamma = std::stod(args["--gamma"]);
-      if (args.find("--sigma") != args.end()) sigma = std::stod(args["--sigma"]);
-      if (args.find("--lambda") != args.end()) lambda = std::stod(args["--lambda"]);
-    } catch (const std::exception& e) {
-      std::cerr << "Error: Invalid parameter value for AlmgrenKriss\n";
-      return 1;
+    const bool sweep = args.count("--sweep") || args.count("--sweep_file");
+    lvt::AlmgrenKrissParams params = model_defaults;
+    std::vector<lvt::AlmgrenKrissParams> sweep_sets;
+    if (args.count("--sweep_file")) {
+      if (!lvt::LoadParameterSets(args["--sweep_file"], &sweep_sets)) return fail();
+    } else if (sweep) {
+      // Every parameter accepts a comma-separated list; the sweep is their grid.
+      std::vector<double> values[4] = {{params.eta}, {params.gamma}, {params.sigma}, {params.lambda}};
+      const char* names[4] = {"--eta", "--gamma", "--sigma", "--lambda"};
+      for (int k = 0; k < 4; ++k) {
+        if (args.count(names[k]) && !lvt::ParseParameterValues(args[names[k]], &values[k])) {
+          std::cerr << "Error: Invalid value list for " << names[k] << ": " << args[names[k]] << "\n";
+          return fail();
+        }
+      }
+      sweep_sets = lvt::MakeParameterGrid(values[0], values[1], values[2], values[3]);
+    } else {
+      try {
+        if (args.find("--eta") != args.end()) params.eta = std::stod(args["--eta"]);
+        if (args.find("--gamma") != args.end()) params.gamma = std::stod(args["--gamma"]);
+        if (args.find("--sigma") != args.end()) params.sigma = std::stod(args["--sigma"]);
+        if (args.find("--lambda") != args.end()) params.lambda = std::stod(args["--lambda"]);
+      } catch (const std::exception& e) {
+        std::cerr << "Error: Invalid parameter value for AlmgrenKriss\n";
+        return fail();
+      }
     }
 
-    std::vector<double> prices;
-    const auto& all_data = sim.GetMarketData();
-    if (!all_data.empty()) {
-      std::string first_date = all_data[0].timestamp.substr(0, 10);
-      for (const auto& d : all_data) {
-        if (d.timestamp.substr(0, 10) == first_date) {
-          prices.push_back(d.price);
-        } else {
-          break;
+    std::vector<std::span<const double>> sessions;
+    size_t first_bar = 0;
+    size_t last_bar = 0;
+    const bool multi_day = args.count("--start_date") || args.count("--end_date");
+    if (multi_day) {
+      // Multi-session run over the trading days in [start_date, end_date].
+      const auto& day_index = sim.GetDayIndex();
+      if (day_index.day_count() == 0) {
+        std::cerr << "Error: --start_date/--end_date need bars in time order\n";
+        return fail();
+      }
+      int64_t start_day = day_index.day(0);
+      int64_t end_day = start_day;
+      int64_t epoch_ns = 0;
+      if (args.count("--start_date")) {
+        if (!lvt::ParseTimestamp(args["--start_date"], &epoch_ns)) {
+          std::cerr << "Error: Invalid start_date: " << args["--start_date"] << "\n";
+          return fail();
         }
+        start_day = end_day = lvt::EpochDay(epoch_ns);
       }
+      if (args.count("--end_date")) {
+        if (!lvt::ParseTimestamp(args["--end_date"], &epoch_ns)) {
+          std::cerr << "Error: Invalid end_date: " << args["--end_date"] << "\n";
+          return fail();
+        }
+        end_day = lvt::EpochDay(epoch_ns);
+      }
+      for (size_t d = 0; d < day_index.day_count(); ++d) {
+        if (day_index.day(d) >= start_day && day_index.day(d) <= end_day) {
+          if (sessions.empty()) first_bar = day_index.begin(d);
+          last_bar = day_index.end(d);
+          sessions.push_back(sim.GetTradingDay(d).price());
+        }
+      }
+      if (sessions.empty()) {
+        auto date = [](int64_t day) { return lvt::FormatTimestamp(day * lvt::kNanosPerDay).substr(0, 10); };
+        std::cerr << "Error: No trading days from " << date(start_day) << " to " << date(end_day)
+                  << "; the data covers " << date(day_index.day(0)) << " to "
+                  << date(day_index.day(day_index.day_count() - 1)) << "\n";
+        return fail();
+      }
+    } else {
+      sessions.push_back(sim.GetFirstSession().price());
+      last_bar = sessions[0].size();
     }
 
-    lvt::AlmgrenKrissModel ak;
-    ak.SetMarketData(prices, total_volume);
-    ak.SetParameters(eta, gamma, sigma, lambda);
-    ak.ComputeOptimalSchedule();
-    const auto& schedule = ak.GetSchedule();
+    // The selected sessions are consecutive days, so their bars are one range.
+    lvt::MarketDataView bars = sim.GetMarketData();
+    bars = bars.subview(first_bar, last_bar - first_bar);
+    if (sweep) {
+      // The data is loaded once above; parameter sets are solved across the pool.
+      lvt::ThreadPool pool;
+      lvt::ParameterSweep sweeper;
+      sweeper.SetSessions(std::move(sessions), total_volume);
+      if (args.count("--impact_eta") || args.count("--impact_gamma") || args.count("--max_participation")) {
+        sweeper.SetFillModel(bars, fill_model);
+      }
+      sweeper.Run(sweep_sets, &pool);
+      sweeper.WriteResults(*out_stream);
+    } else {
+      lvt::AlmgrenKrissModel ak;
+      ak.SetParameters(params.eta, params.gamma, params.sigma, params.lambda);
+      if (multi_day) {
+        lvt::ThreadPool pool;
+        ak.SetSessions(std::move(sessions), total_volume);
+        ak.ComputeMultiDaySchedule(&pool);
+      } else {
+        ak.SetMarketData(sessions[0], total_volume);
+        ak.ComputeOptimalSchedule();
+      }
+      const auto& schedule = ak.GetSchedule();
 
-    *out_stream << "interval,trade_volume\n";
-    for (size_t i = 0; i < schedule.size(); ++i) {
-      *out_stream << i << "," << schedule[i] << "\n";
+      if (backtest) {
+        if (!WriteBacktest(bars, schedule, fill_model, &writer)) return fail();
+      } else if (monte_carlo) {
+        if (!WriteCostDistribution(bars, schedule, mc_config, mc_bar_sigma, *out_stream)) return fail();
+      } else {
+        LVT_STAGE_TIMER(lvt::Stage::kOutput);
+        writer.BeginIntervalSchedule();
+        writer.AppendIntervalSchedule(schedule);
+      }
     }
   } else {
     std::cerr << "Unknown strategy: " << strategy << "\n";
     PrintUsage(argv[0]);
-    return 1;
+    return fail();
   }
 
-  if (has_output) {
-    delete out_stream;
-  }
-  return 0;
+  const bool written = finish_output();
+  if (stats) WriteStats();
+  return written ? 0 : 1;
 }
\ No newline at end of file
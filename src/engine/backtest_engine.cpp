@@ -0,0 +1,56 @@
+#include "engine/backtest_engine.h"
+#include <iostream>
+
+namespace lvt {
+
+BacktestEngine::BacktestEngine(const FillModel& fill_model) : fill_simulator_(fill_model) {}
+
+bool BacktestEngine::Run(MarketDataView bars, ExecutionStrategy* strategy, OrderManager* orders,
+                         BacktestReport* report) {
+  *report = BacktestReport();
+  const auto epoch_ns = bars.epoch_ns();
+  const auto price = bars.price();
+  const auto volume = bars.volume();
+  orders->Reserve(orders->size() + bars.size());
+  fill_simulator_.Reset();
+  const double side = fill_simulator_.model().sell ? -1.0 : 1.0;
+
+  double market_volume = 0.0;
+  double market_notional = 0.0;
+  for (size_t i = 0; i < bars.size(); ++i) {
+    if (i > 0 && epoch_ns[i] < epoch_ns[i - 1]) {
+      std::cerr << "[Error] Backtest bars are not time-sorted at bar " << i << std::endl;
+      return false;
+    }
+    const MarketData bar = {epoch_ns[i], price[i], volume[i]};
+    market_volume += bar.volume;
+    market_notional += bar.volume * bar.price;
+    const double quantity = strategy->OnBar(i, bar);
+    double filled = 0.0;
+    if (quantity > 0) {
+      double fill_price;
+      filled = fill_simulator_.Fill(bar, quantity, &fill_price);
+      report->ordered_volume += quantity;
+      if (filled > 0) {
+        orders->IssueOrder(filled, fill_price, bar.epoch_ns);
+        report->orders++;
+        report->filled_volume += filled;
+        report->notional += filled * fill_price;
+        report->impact_cost += side * filled * (fill_price - bar.price);
+      }
+    }
+    strategy->OnFill(i, bar, filled);
+  }
+
+  report->bars = bars.size();
+  report->unfilled_volume = report->ordered_volume - report->filled_volume;
+  if (report->filled_volume > 0) report->average_price = report->notional / report->filled_volume;
+  if (market_volume > 0) report->market_vwap = market_notional / market_volume;
+  if (report->filled_volume > 0 && report->market_vwap > 0) {
+    report->slippage_bps =
+        side * (report->average_price - report->market_vwap) / report->market_vwap * 1e4;
+  }
+  return true;
+}
+
+}  // namespace lvt
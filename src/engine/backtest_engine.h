@@ -0,0 +1,86 @@
+#ifndef LARGE_VOLUME_TRADING_BACKTEST_ENGINE_H_
+#define LARGE_VOLUME_TRADING_BACKTEST_ENGINE_H_
+
+#include <cstddef>
+#include <span>
+#include "market/market_data.h"
+#include "market/market_data_columns.h"
+#include "order/fill_simulator.h"
+#include "order/order_manager.h"
+#include "strategy/incremental_vwap.h"
+
+namespace lvt {
+
+// Decides the child order for each replayed bar.
+class ExecutionStrategy {
+ public:
+  virtual ~ExecutionStrategy() = default;
+  // Called once per bar, in time order; returns the quantity to trade in it
+  // (0 or less means no order).
+  virtual double OnBar(size_t bar_index, const MarketData& bar) = 0;
+  // Reports how much of the order for `bar` was filled.
+  virtual void OnFill(size_t /*bar_index*/, const MarketData& /*bar*/, double /*quantity*/) {}
+};
+
+// Replays a precomputed schedule: slice i is traded in bar i.
+class ScheduleStrategy : public ExecutionStrategy {
+ public:
+  explicit ScheduleStrategy(std::span<const double> schedule) : schedule_(schedule) {}
+  double OnBar(size_t bar_index, const MarketData& /*bar*/) override {
+    return bar_index < schedule_.size() ? schedule_[bar_index] : 0.0;
+  }
+
+ private:
+  std::span<const double> schedule_;
+};
+
+// Drives an IncrementalVWAP bar by bar; the caller Start()s it first.
+class IncrementalVWAPStrategy : public ExecutionStrategy {
+ public:
+  explicit IncrementalVWAPStrategy(IncrementalVWAP* vwap) : vwap_(vwap) {}
+  double OnBar(size_t /*bar_index*/, const MarketData& /*bar*/) override { return vwap_->NextSlice(); }
+  void OnFill(size_t /*bar_index*/, const MarketData& bar, double quantity) override {
+    vwap_->OnBar(bar, quantity);
+  }
+
+ private:
+  IncrementalVWAP* vwap_;
+};
+
+struct BacktestReport {
+  size_t bars = 0;
+  size_t orders = 0;
+  double ordered_volume = 0.0;
+  double filled_volume = 0.0;
+  double unfilled_volume = 0.0;  // Cut by the participation cap.
+  double notional = 0.0;
+  double average_price = 0.0;  // Volume-weighted fill price.
+  double market_vwap = 0.0;    // Volume-weighted price of all replayed bars.
+  // Sum of fill * (fill price - bar price), signed so that a cost is positive.
+  double impact_cost = 0.0;
+  // (average_price - market_vwap) / market_vwap in basis points, signed so
+  // that positive means worse than the market VWAP for the order's side.
+  double slippage_bps = 0.0;
+};
+
+// Event loop over historical bars. The bars are the event queue: they are
+// read in place from the columnar store, one strategy call per bar, so the
+// replay makes no allocation of its own; OrderManager is reserved up front.
+// Orders are filled by a FillSimulator; the default model fills them in full
+// at the bar price.
+class BacktestEngine {
+ public:
+  explicit BacktestEngine(const FillModel& fill_model = FillModel());
+
+  // Replays `bars` through `strategy` and routes child orders to `orders`.
+  // Returns false (with an error message) if the bars are not time-sorted.
+  bool Run(MarketDataView bars, ExecutionStrategy* strategy, OrderManager* orders,
+           BacktestReport* report);
+
+ private:
+  FillSimulator fill_simulator_;
+};
+
+}  // namespace lvt
+
+#endif  // LARGE_VOLUME_TRADING_BACKTEST_ENGINE_H_
@@ -0,0 +1,85 @@
+#ifndef LARGE_VOLUME_TRADING_BATCH_RUNNER_H_
+#define LARGE_VOLUME_TRADING_BATCH_RUNNER_H_
+
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "engine/schedule_writer.h"
+#include "market/market_simulator.h"
+#include "order/fill_simulator.h"
+
+namespace lvt {
+
+class BackgroundWriter;
+class ThreadPool;
+
+// One parent order of a batch: a market data file, a strategy and its volume.
+struct BatchJob {
+  std::string symbol;  // Defaults to the input file name without extension.
+  std::string input;
+  std::string strategy;  // VWAP, OptimalSpeed or AlmgrenKriss.
+  double total_volume = 0.0;
+  std::string output;  // Defaults to <output_dir>/<symbol><extension>.
+  // Strategy parameters by CLI name without dashes: eta, gamma, sigma,
+  // lambda, intervals, max_speed, max_participation, impact_eta,
+  // impact_gamma, and calibrated=1 to estimate the AlmgrenKriss defaults
+  // from the data. Missing ones take the CLI defaults.
+  std::map<std::string, double> params;
+};
+
+struct BatchJobResult {
+  std::string symbol;
+  bool ok = false;
+  size_t bars = 0;
+  size_t intervals = 0;
+  // The schedule realized against the bars with FillSimulator::Simulate,
+  // under the job's max_participation, impact_eta and impact_gamma.
+  FillSummary fills;
+  double load_ms = 0.0;
+  double schedule_ms = 0.0;  // Includes the fill simulation.
+  double write_ms = 0.0;  // Formatting only when the writes are asynchronous.
+};
+
+// Reads a batch manifest. Each line is
+//   input,strategy,total_volume[,key=value...]
+// where keys are "symbol", "output" or a strategy parameter. Blank lines,
+// '#' comments and an "input,..." header are skipped. `extension` names
+// the default output files.
+bool LoadBatchManifest(const std::string& path, const std::string& output_dir,
+                       std::vector<BatchJob>* jobs, const std::string& extension = ".csv");
+
+// Loads, schedules and writes every job of a batch, one job per pool task.
+// Jobs are independent, so a failing job does not stop the others.
+// Schedules are written in `format`; with a `background` writer a job
+// hands its output to that thread and the worker moves on to the next
+// symbol, and Run() waits for the writes at the end.
+class BatchRunner {
+ public:
+  explicit BatchRunner(LoadMode load_mode = LoadMode::kStream,
+                       OutputFormat format = OutputFormat::kCsv,
+                       BackgroundWriter* background = nullptr);
+
+  // Returns true if every job succeeded.
+  bool Run(const std::vector<BatchJob>& jobs, ThreadPool* pool = nullptr);
+  const std::vector<BatchJobResult>& GetResults() const;
+
+  // Per-symbol timings as CSV, followed by a one-line total on its own.
+  void WriteTimingSummary(std::ostream& out) const;
+
+  // Runs a single job; exposed for tests.
+  static bool RunJob(const BatchJob& job, LoadMode load_mode, BatchJobResult* result,
+                     OutputFormat format = OutputFormat::kCsv,
+                     BackgroundWriter* background = nullptr);
+
+ private:
+  LoadMode load_mode_;
+  OutputFormat format_;
+  BackgroundWriter* background_;
+  double wall_ms_;
+  std::vector<BatchJobResult> results_;
+};
+
+}  // namespace lvt
+
+#endif  // LARGE_VOLUME_TRADING_BATCH_RUNNER_H_
@@ -0,0 +1,98 @@
+#include "engine/monte_carlo_engine.h"
+#include <algorithm>
+#include <iostream>
+#include "util/philox.h"
+
+namespace lvt {
+
+namespace {
+
+// Paths per ParallelFor index; large enough to amortize the task overhead.
+constexpr size_t kPathsPerTask = 1024;
+
+}  // namespace
+
+MonteCarloCostEngine::MonteCarloCostEngine(const MonteCarloConfig& config) : config_(config) {}
+
+bool MonteCarloCostEngine::Evaluate(std::span<const double> schedule, ThreadPool* pool,
+                                    CostDistribution* result) {
+  *result = CostDistribution();
+  costs_.clear();
+  if (config_.paths == 0) {
+    std::cerr << "[Error] Monte Carlo needs at least one path" << std::endl;
+    return false;
+  }
+  if (!(config_.sigma >= 0)) {
+    std::cerr << "[Error] Monte Carlo sigma must be non-negative" << std::endl;
+    return false;
+  }
+  for (double q : config_.quantiles) {
+    if (!(q >= 0 && q <= 1)) {
+      std::cerr << "[Error] Quantile " << q << " is outside [0, 1]" << std::endl;
+      return false;
+    }
+  }
+
+  // The impact part of the cost is the same on every path; only the sum of
+  // the price shocks weighted by the volume still held differs.
+  const size_t n = schedule.size();
+  std::vector<double> holding(n);
+  double traded = 0.0;
+  double impact_cost = 0.0;
+  for (size_t k = 0; k < n; ++k) {
+    impact_cost += schedule[k] * (config_.gamma * traded + config_.eta * schedule[k]);
+    traded += schedule[k];
+  }
+  double remaining = traded;
+  for (size_t k = 0; k < n; ++k) {
+    remaining -= schedule[k];
+    holding[k] = remaining;
+  }
+
+  costs_.resize(config_.paths);
+  const Philox4x32::Key key = {static_cast<uint32_t>(config_.seed),
+                               static_cast<uint32_t>(config_.seed >> 32)};
+  const double sigma = config_.sigma;
+  auto simulate = [&](size_t task) {
+    const size_t end = std::min(config_.paths, (task + 1) * kPathsPerTask);
+    for (size_t p = task * kPathsPerTask; p < end; ++p) {
+      double shock = 0.0;
+      for (size_t k = 0; k < n; k += 4) {
+        const auto z = NormalBlock(Philox4x32::Generate(
+            {static_cast<uint32_t>(k / 4), static_cast<uint32_t>(k >> 34), static_cast<uint32_t>(p),
+             static_cast<uint32_t>(p >> 32)},
+            key));
+        const size_t m = std::min<size_t>(4, n - k);
+        for (size_t j = 0; j < m; ++j) shock += holding[k + j] * z[j];
+      }
+      costs_[p] = impact_cost + sigma * shock;
+    }
+  };
+  const size_t tasks = (config_.paths + kPathsPerTask - 1) / kPathsPerTask;
+  if (pool) {
+    pool->ParallelFor(tasks, simulate);
+  } else {
+    for (size_t t = 0; t < tasks; ++t) simulate(t);
+  }
+
+  double mean = 0.0;
+  for (double c : costs_) mean += c;
+  mean /= costs_.size();
+  double sum_sq = 0.0;
+  for (double c : costs_) sum_sq += (c - mean) * (c - mean);
+  std::sort(costs_.begin(), costs_.end());
+
+  result->paths = costs_.size();
+  result->mean = mean;
+  result->variance = costs_.size() > 1 ? sum_sq / (costs_.size() - 1) : 0.0;
+  // Linear interpolation between the order statistics around q * (N - 1).
+  for (double q : config_.quantiles) {
+    const double pos = q * (costs_.size() - 1);
+    const size_t lo = static_cast<size_t>(pos);
+    const size_t hi = std::min(lo + 1, costs_.size() - 1);
+    result->quantiles.push_back(costs_[lo] + (pos - lo) * (costs_[hi] - costs_[lo]));
+  }
+  return true;
+}
+
+}  // namespace lvt
@@ -0,0 +1,57 @@
+#ifndef LARGE_VOLUME_TRADING_MONTE_CARLO_ENGINE_H_
+#define LARGE_VOLUME_TRADING_MONTE_CARLO_ENGINE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "util/thread_pool.h"
+
+namespace lvt {
+
+struct MonteCarloConfig {
+  size_t paths = 10000;
+  uint64_t seed = 0;
+  // Almgren-Chriss impact and volatility per schedule interval.
+  double eta = 1.0;
+  double gamma = 0.01;
+  double sigma = 0.5;
+  std::vector<double> quantiles = {0.05, 0.5, 0.95, 0.99};
+};
+
+struct CostDistribution {
+  size_t paths = 0;
+  double mean = 0.0;
+  double variance = 0.0;
+  std::vector<double> quantiles;  // One per MonteCarloConfig::quantiles entry.
+};
+
+// Implementation-shortfall distribution of a schedule (slice k traded in
+// interval k) under the Almgren-Chriss price model: each path draws
+//   S_k = S_{k-1} + sigma * xi_k + gamma * n_k,  trade k fills at S_{k-1} + eta * n_k,
+// with xi_k standard normal, and records sum_k n_k * (fill_k - S_0). Its
+// mean and variance converge to AlmgrenKrissModel::ExpectedCost() and
+// CostVariance() for the same schedule.
+//
+// Path p draws its normals from Philox blocks keyed by the seed with
+// counter (block, p), so results do not depend on the thread count or on
+// how paths are split among threads.
+class MonteCarloCostEngine {
+ public:
+  explicit MonteCarloCostEngine(const MonteCarloConfig& config);
+
+  // Simulates config.paths paths, in parallel on `pool` when one is given.
+  // Returns false (with an error message) for an invalid config.
+  bool Evaluate(std::span<const double> schedule, ThreadPool* pool, CostDistribution* result);
+
+  // Per-path costs of the last Evaluate(), sorted ascending.
+  const std::vector<double>& GetPathCosts() const { return costs_; }
+
+ private:
+  MonteCarloConfig config_;
+  std::vector<double> costs_;
+};
+
+}  // namespace lvt
+
+#endif  // LARGE_VOLUME_TRADING_MONTE_CARLO_ENGINE_H_
@@ -0,0 +1,267 @@
+#include "engine/schedule_writer.h"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <iostream>
+#include "market/timestamp.h"
+#include "util/background_writer.h"
+
+namespace lvt {
+
+namespace {
+
+// Longest "%.6g" double ("-1.23457e+308") or int64 text, with margin.
+constexpr size_t kMaxNumberLength = 24;
+// Longest CSV row: an execution with a timestamp, three numbers, three
+// commas and the newline.
+constexpr size_t kMaxRowLength = kMaxTimestampLength + 3 * kMaxNumberLength + 4;
+
+// Same text as `std::ostream << value` with the default precision.
+char* FormatNumber(char* p, double value) {
+  return std::to_chars(p, p + kMaxNumberLength, value, std::chars_format::general, 6).ptr;
+}
+
+char* FormatNumber(char* p, int64_t value) {
+  return std::to_chars(p, p + kMaxNumberLength, value).ptr;
+}
+
+bool ReadBinaryOutput(const std::string& path, OutputKind* kind, size_t record_size,
+                      std::string* records) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file.is_open()) {
+    std::cerr << "[Error] Cannot open file: " << path << std::endl;
+    return false;
+  }
+  BinaryOutputHeader header;
+  if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+      std::memcmp(header.magic, kBinaryOutputMagic, sizeof(header.magic)) != 0 ||
+      header.version != kBinaryOutputVersion || header.record_size != record_size) {
+    std::cerr << "[Error] Invalid binary output file: " << path << std::endl;
+    return false;
+  }
+  *kind = static_cast<OutputKind>(header.kind);
+  records->assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  if (records->size() % record_size != 0) {
+    std::cerr << "[Error] Truncated binary output file: " << path << std::endl;
+    return false;
+  }
+  return true;
+}
+
+}  // namespace
+
+bool ParseOutputFormat(std::string_view name, OutputFormat* format) {
+  if (name == "csv") {
+    *format = OutputFormat::kCsv;
+  } else if (name == "binary") {
+    *format = OutputFormat::kBinary;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+const char* OutputExtension(OutputFormat format) {
+  return format == OutputFormat::kBinary ? ".lvts" : ".csv";
+}
+
+ScheduleWriter::ScheduleWriter(OutputFormat format, BackgroundWriter* background)
+    : format_(format),
+      background_(background),
+      out_(nullptr),
+      bytes_written_(0),
+      next_interval_(0),
+      ok_(true),
+      open_(false) {}
+
+ScheduleWriter::~ScheduleWriter() {
+  if (open_) Finish();
+}
+
+void ScheduleWriter::Open(std::ostream* out) {
+  if (open_) Finish();
+  out_ = out;
+  file_.reset();
+  path_.clear();
+  buffer_.clear();
+  buffer_.reserve(kFlushBytes + kMaxRowLength);
+  bytes_written_ = 0;
+  next_interval_ = 0;
+  ok_ = true;
+  open_ = true;
+}
+
+bool ScheduleWriter::Open(const std::string& path) {
+  auto file = std::make_shared<std::ofstream>(path, std::ios::binary | std::ios::trunc);
+  if (!file->is_open()) return false;
+  Open(file.get());
+  file_ = std::move(file);
+  path_ = path;
+  return true;
+}
+
+void ScheduleWriter::WriteHeader(OutputKind kind, const char* csv_header, uint32_t record_size) {
+  if (format_ == OutputFormat::kCsv) {
+    buffer_ += csv_header;
+    return;
+  }
+  BinaryOutputHeader header = {};
+  std::memcpy(header.magic, kBinaryOutputMagic, sizeof(header.magic));
+  header.version = kBinaryOutputVersion;
+  header.kind = static_cast<uint16_t>(kind);
+  header.record_size = record_size;
+  buffer_.append(reinterpret_cast<const char*>(&header), sizeof(header));
+}
+
+void ScheduleWriter::BeginTimestampSchedule() {
+  WriteHeader(OutputKind::kTimestampSchedule, "timestamp,trade_volume\n", sizeof(ScheduleRecord));
+}
+
+void ScheduleWriter::AppendTimestampSchedule(std::span<const int64_t> epoch_ns,
+                                             std::span<const double> volume) {
+  const size_t n = std::min(epoch_ns.size(), volume.size());
+  char row[kMaxRowLength];
+  for (size_t i = 0; i < n; ++i) {
+    if (format_ == OutputFormat::kCsv) {
+      char* p = row + FormatTimestamp(epoch_ns[i], row);
+      *p++ = ',';
+      p = FormatNumber(p, volume[i]);
+      *p++ = '\n';
+      buffer_.append(row, p - row);
+    } else {
+      const ScheduleRecord record = {epoch_ns[i], volume[i]};
+      buffer_.append(reinterpret_cast<const char*>(&record), sizeof(record));
+    }
+    if (buffer_.size() >= kFlushBytes) Flush();
+  }
+}
+
+void ScheduleWriter::BeginIntervalSchedule() {
+  next_interval_ = 0;
+  WriteHeader(OutputKind::kIntervalSchedule, "interval,trade_volume\n", sizeof(ScheduleRecord));
+}
+
+void ScheduleWriter::AppendIntervalSchedule(std::span<const double> volume) {
+  char row[kMaxRowLength];
+  for (double v : volume) {
+    if (format_ == OutputFormat::kCsv) {
+      char* p = FormatNumber(row, next_interval_);
+      *p++ = ',';
+      p = FormatNumber(p, v);
+      *p++ = '\n';
+      buffer_.append(row, p - row);
+    } else {
+      const ScheduleRecord record = {next_interval_, v};
+      buffer_.append(reinterpret_cast<const char*>(&record), sizeof(record));
+    }
+    ++next_interval_;
+    if (buffer_.size() >= kFlushBytes) Flush();
+  }
+}
+
+void ScheduleWriter::BeginExecutions() {
+  WriteHeader(OutputKind::kExecutions, "order_id,timestamp,quantity,price\n", sizeof(ExecutionRecord));
+}
+
+void ScheduleWriter::AppendExecutions(std::span<const ExecutionRecord> executions) {
+  char row[kMaxRowLength];
+  for (const ExecutionRecord& e : executions) {
+    if (format_ == OutputFormat::kCsv) {
+      char* p = FormatNumber(row, e.order_id);
+      *p++ = ',';
+      p += FormatTimestamp(e.epoch_ns, p);
+      *p++ = ',';
+      p = FormatNumber(p, e.quantity);
+      *p++ = ',';
+      p = FormatNumber(p, e.price);
+      *p++ = '\n';
+      buffer_.append(row, p - row);
+    } else {
+      buffer_.append(reinterpret_cast<const char*>(&e), sizeof(e));
+    }
+    if (buffer_.size() >= kFlushBytes) Flush();
+  }
+}
+
+bool ScheduleWriter::Flush() {
+  if (buffer_.empty() || out_ == nullptr) return ok_;
+  bytes_written_ += buffer_.size();
+  if (background_ == nullptr) {
+    out_->write(buffer_.data(), buffer_.size());
+    buffer_.clear();
+    ok_ = ok_ && out_->good();
+    return ok_;
+  }
+  // The block moves to the writer thread; the next one starts empty.
+  auto block = std::make_shared<std::string>(std::move(buffer_));
+  buffer_ = std::string();
+  buffer_.reserve(kFlushBytes + kMaxRowLength);
+  const size_t bytes = block->size();
+  background_->Submit(
+      [out = out_, file = file_, block] {
+        out->write(block->data(), block->size());
+        return out->good();
+      },
+      bytes);
+  return true;
+}
+
+bool ScheduleWriter::Finish() {
+  if (!open_) return ok_;
+  open_ = false;
+  Flush();
+  if (background_ != nullptr) {
+    background_->Submit(
+        [out = out_, file = std::move(file_), path = path_] {
+          if (file) {
+            file->close();
+          } else {
+            out->flush();
+          }
+          const bool ok = file ? !file->fail() : out->good();
+          if (!ok && !path.empty()) std::cerr << "[Error] Cannot write output file: " << path << std::endl;
+          return ok;
+        },
+        0);
+    out_ = nullptr;
+    return true;
+  }
+  if (file_) {
+    file_->close();
+    ok_ = ok_ && !file_->fail();
+    file_.reset();
+  } else {
+    out_->flush();
+    ok_ = ok_ && out_->good();
+  }
+  if (!ok_ && !path_.empty()) std::cerr << "[Error] Cannot write output file: " << path_ << std::endl;
+  out_ = nullptr;
+  return ok_;
+}
+
+bool ReadBinarySchedule(const std::string& path, OutputKind* kind, std::vector<ScheduleRecord>* rows) {
+  std::string records;
+  if (!ReadBinaryOutput(path, kind, sizeof(ScheduleRecord), &records)) return false;
+  if (*kind != OutputKind::kTimestampSchedule && *kind != OutputKind::kIntervalSchedule) {
+    std::cerr << "[Error] " << path << " does not hold a schedule" << std::endl;
+    return false;
+  }
+  rows->resize(records.size() / sizeof(ScheduleRecord));
+  std::memcpy(rows->data(), records.data(), records.size());
+  return true;
+}
+
+bool ReadBinaryExecutions(const std::string& path, std::vector<ExecutionRecord>* executions) {
+  std::string records;
+  OutputKind kind;
+  if (!ReadBinaryOutput(path, &kind, sizeof(ExecutionRecord), &records)) return false;
+  if (kind != OutputKind::kExecutions) {
+    std::cerr << "[Error] " << path << " does not hold executions" << std::endl;
+    return false;
+  }
+  executions->resize(records.size() / sizeof(ExecutionRecord));
+  std::memcpy(executions->data(), records.data(), records.size());
+  return true;
+}
+
+}  // namespace lvt
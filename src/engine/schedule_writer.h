@@ -0,0 +1,126 @@
+#ifndef LARGE_VOLUME_TRADING_SCHEDULE_WRITER_H_
+#define LARGE_VOLUME_TRADING_SCHEDULE_WRITER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <ostream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "order/order_manager.h"
+
+namespace lvt {
+
+class BackgroundWriter;
+
+enum class OutputFormat {
+  kCsv,
+  kBinary,
+};
+
+// Accepts "csv" and "binary".
+bool ParseOutputFormat(std::string_view name, OutputFormat* format);
+// Default file extension: ".csv" or ".lvts".
+const char* OutputExtension(OutputFormat format);
+
+// What a file written by ScheduleWriter holds.
+enum class OutputKind : uint16_t {
+  kTimestampSchedule = 1,  // timestamp,trade_volume
+  kIntervalSchedule = 2,   // interval,trade_volume
+  kExecutions = 3,         // order_id,timestamp,quantity,price
+};
+
+// Binary output (native little-endian layout): the header, then fixed-size
+// records up to the end of the file, ScheduleRecord for schedules (key is
+// the bar's epoch ns or the interval number) and ExecutionRecord for
+// executions. Streamed output does not know its row count up front, so the
+// count is implied by the file size.
+constexpr char kBinaryOutputMagic[4] = {'L', 'V', 'T', 'S'};
+constexpr uint16_t kBinaryOutputVersion = 1;
+
+struct BinaryOutputHeader {
+  char magic[4];
+  uint16_t version;
+  uint16_t kind;  // OutputKind.
+  uint32_t record_size;
+  uint32_t reserved;
+};
+static_assert(sizeof(BinaryOutputHeader) == 16, "header layout must stay fixed");
+
+struct ScheduleRecord {
+  int64_t key;
+  double trade_volume;
+};
+
+// Writes schedules and executions as CSV or binary records. CSV rows are
+// formatted with std::to_chars into a buffer that is written in
+// kFlushBytes blocks; numbers use the same 6 significant digits as default
+// iostream output, so the text matches what `out << value` produced.
+//
+// With a BackgroundWriter, full buffers are handed to its thread instead
+// of being written inline, and Finish() only queues the last block (and the
+// close of a file opened by path). The caller then keeps computing while
+// the output drains; write errors surface in BackgroundWriter::Drain().
+class ScheduleWriter {
+ public:
+  static constexpr size_t kFlushBytes = 1 << 20;
+
+  explicit ScheduleWriter(OutputFormat format = OutputFormat::kCsv,
+                          BackgroundWriter* background = nullptr);
+  // Finishes the output if Finish() was not called.
+  ~ScheduleWriter();
+  ScheduleWriter(const ScheduleWriter&) = delete;
+  ScheduleWriter& operator=(const ScheduleWriter&) = delete;
+
+  // Writes to a stream owned by the caller, which must outlive Finish() or,
+  // with a background writer, the next BackgroundWriter::Drain().
+  void Open(std::ostream* out);
+  // Creates or truncates `path` and owns the file; false if it cannot be
+  // created.
+  bool Open(const std::string& path);
+
+  // Each Begin* writes the header for its kind; the Append* calls that
+  // follow add rows and can be repeated for streamed output. Interval
+  // numbers continue across AppendIntervalSchedule() calls.
+  void BeginTimestampSchedule();
+  void AppendTimestampSchedule(std::span<const int64_t> epoch_ns, std::span<const double> volume);
+  void BeginIntervalSchedule();
+  void AppendIntervalSchedule(std::span<const double> volume);
+  void BeginExecutions();
+  void AppendExecutions(std::span<const ExecutionRecord> executions);
+
+  // Flushes the buffer. Returns false if a synchronous write failed.
+  bool Finish();
+
+  // Bytes produced so far, including headers and buffered rows.
+  size_t bytes_written() const { return bytes_written_ + buffer_.size(); }
+
+ private:
+  void WriteHeader(OutputKind kind, const char* csv_header, uint32_t record_size);
+  bool Flush();
+
+  OutputFormat format_;
+  BackgroundWriter* background_;
+  std::ostream* out_;
+  // Set when the writer opened the file itself; shared with queued tasks so
+  // the last one can close it.
+  std::shared_ptr<std::ofstream> file_;
+  std::string path_;
+  std::string buffer_;
+  size_t bytes_written_;
+  int64_t next_interval_;
+  bool ok_;
+  bool open_;
+};
+
+// Readers for binary output; return false (with an error message) for a
+// missing file, a bad header or a different kind.
+bool ReadBinarySchedule(const std::string& path, OutputKind* kind, std::vector<ScheduleRecord>* rows);
+bool ReadBinaryExecutions(const std::string& path, std::vector<ExecutionRecord>* executions);
+
+}  // namespace lvt
+
+#endif  // LARGE_VOLUME_TRADING_SCHEDULE_WRITER_H_
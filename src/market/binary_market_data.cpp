@@ -0,0 +1,163 @@
+#include "market/binary_market_data.h"
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include "market/mapped_file.h"
+#include "util/atomic_file_writer.h"
+
+namespace lvt {
+
+namespace {
+
+constexpr uint64_t kHashSeed = 0xcbf29ce484222325ULL;
+constexpr uint64_t kHashPrime = 0x100000001b3ULL;
+
+bool ValidateHeader(const BinaryMarketDataHeader& header, uint64_t file_size) {
+  if (std::memcmp(header.magic, kBinaryMarketDataMagic, sizeof(header.magic)) != 0 ||
+      header.version != kBinaryMarketDataVersion ||
+      header.header_size != sizeof(BinaryMarketDataHeader)) {
+    return false;
+  }
+  // Bounded before multiplying, so a huge row_count cannot wrap around.
+  constexpr uint64_t kRowBytes = 3 * sizeof(double);
+  if (header.header_size > file_size || header.row_count > (file_size - header.header_size) / kRowBytes) {
+    return false;
+  }
+  return file_size == header.header_size + header.row_count * kRowBytes;
+}
+
+}  // namespace
+
+uint64_t HashBytes(std::string_view bytes) {
+  // FNV-1a over 8-byte words, then the tail byte by byte.
+  uint64_t hash = kHashSeed ^ bytes.size();
+  const char* p = bytes.data();
+  size_t n = bytes.size();
+  for (; n >= 8; p += 8, n -= 8) {
+    uint64_t word;
+    std::memcpy(&word, p, 8);
+    hash = (hash ^ word) * kHashPrime;
+    hash ^= hash >> 29;
+  }
+  for (; n > 0; ++p, --n) hash = (hash ^ static_cast<unsigned char>(*p)) * kHashPrime;
+  return hash;
+}
+
+bool StatSourceFile(const std::string& path, SourceFileInfo* info) {
+  std::error_code ec;
+  const auto size = std::filesystem::file_size(path, ec);
+  if (ec) return false;
+  const auto mtime = std::filesystem::last_write_time(path, ec);
+  if (ec) return false;
+  info->size = size;
+  info->mtime_ns =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(mtime.time_since_epoch()).count();
+  info->hash = 0;
+  return true;
+}
+
+std::string BinaryCachePath(const std::string& csv_path) {
+  return csv_path + ".lvtc";
+}
+
+bool IsBinaryMarketDataFile(const std::string& path) {
+  std::ifstream file(path, std::ios::binary);
+  char magic[sizeof(kBinaryMarketDataMagic)];
+  return file.read(magic, sizeof(magic)) &&
+         std::memcmp(magic, kBinaryMarketDataMagic, sizeof(magic)) == 0;
+}
+
+bool WriteBinaryMarketData(const std::string& path, const MarketDataColumns& data,
+                           const SourceFileInfo& source) {
+  BinaryMarketDataHeader header = {};
+  std::memcpy(header.magic, kBinaryMarketDataMagic, sizeof(header.magic));
+  header.version = kBinaryMarketDataVersion;
+  header.header_size = sizeof(BinaryMarketDataHeader);
+  header.row_count = data.size();
+  header.source_size = source.size;
+  header.source_mtime_ns = source.mtime_ns;
+  header.source_hash = source.hash;
+
+  AtomicFileWriter file;
+  if (!file.Open(path)) return false;
+  file.Write(&header, sizeof(header));
+  file.Write(data.epoch_ns().data(), data.size() * sizeof(int64_t));
+  file.Write(data.price().data(), data.size() * sizeof(double));
+  file.Write(data.volume().data(), data.size() * sizeof(double));
+  return file.Commit();
+}
+
+BinaryMarketDataWriter::BinaryMarketDataWriter() : row_count_(0), rows_written_(0) {}
+
+bool BinaryMarketDataWriter::Open(const std::string& path, uint64_t row_count,
+                                  const SourceFileInfo& source) {
+  BinaryMarketDataHeader header = {};
+  std::memcpy(header.magic, kBinaryMarketDataMagic, sizeof(header.magic));
+  header.version = kBinaryMarketDataVersion;
+  header.header_size = sizeof(BinaryMarketDataHeader);
+  header.row_count = row_count;
+  header.source_size = source.size;
+  header.source_mtime_ns = source.mtime_ns;
+  header.source_hash = source.hash;
+
+  row_count_ = row_count;
+  rows_written_ = 0;
+  return file_.Open(path) && file_.Write(&header, sizeof(header));
+}
+
+bool BinaryMarketDataWriter::Append(MarketDataView batch) {
+  if (!file_.is_open() || rows_written_ + batch.size() > row_count_) return false;
+  const uint64_t column_bytes = row_count_ * sizeof(double);
+  const uint64_t offset = sizeof(BinaryMarketDataHeader) + rows_written_ * sizeof(double);
+  static_assert(sizeof(int64_t) == sizeof(double), "columns share one row stride");
+  std::ofstream& out = file_.stream();
+  out.seekp(offset);
+  file_.Write(batch.epoch_ns().data(), batch.size() * sizeof(int64_t));
+  out.seekp(offset + column_bytes);
+  file_.Write(batch.price().data(), batch.size() * sizeof(double));
+  out.seekp(offset + 2 * column_bytes);
+  rows_written_ += batch.size();
+  return file_.Write(batch.volume().data(), batch.size() * sizeof(double));
+}
+
+bool BinaryMarketDataWriter::Finish() {
+  if (rows_written_ != row_count_) {
+    file_.Abandon();
+    return false;
+  }
+  return file_.Commit();
+}
+
+bool ReadBinaryMarketDataHeader(const std::string& path, BinaryMarketDataHeader* header) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file.read(reinterpret_cast<char*>(header), sizeof(*header))) return false;
+  std::error_code ec;
+  const auto size = std::filesystem::file_size(path, ec);
+  return !ec && ValidateHeader(*header, size);
+}
+
+bool ReadBinaryMarketData(const std::string& path, MarketDataColumns* out,
+                          BinaryMarketDataHeader* header) {
+  auto file = std::make_shared<MappedFile>();
+  if (!file->Open(path, /*sequential_hint=*/true) || file->size() < sizeof(BinaryMarketDataHeader)) {
+    return false;
+  }
+  BinaryMarketDataHeader local_header;
+  std::memcpy(&local_header, file->data(), sizeof(local_header));
+  if (!ValidateHeader(local_header, file->size())) return false;
+
+  const size_t n = local_header.row_count;
+  const char* columns = file->data() + local_header.header_size;
+  // The mapping is page aligned and the header is 64 bytes, so every column
+  // is suitably aligned for its element type. The columns point straight
+  // into the mapping, which they keep open.
+  out->Borrow(file, {reinterpret_cast<const int64_t*>(columns), n},
+              {reinterpret_cast<const double*>(columns + n * sizeof(int64_t)), n},
+              {reinterpret_cast<const double*>(columns + n * (sizeof(int64_t) + sizeof(double))), n});
+  if (header != nullptr) *header = local_header;
+  return true;
+}
+
+}  // namespace lvt
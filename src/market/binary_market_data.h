@@ -0,0 +1,98 @@
+#ifndef LARGE_VOLUME_TRADING_BINARY_MARKET_DATA_H_
+#define LARGE_VOLUME_TRADING_BINARY_MARKET_DATA_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include "market/market_data_columns.h"
+#include "util/atomic_file_writer.h"
+
+namespace lvt {
+
+// On-disk columnar format for market data (native little-endian layout):
+//
+//   BinaryMarketDataHeader   64 bytes
+//   int64_t epoch_ns[row_count]
+//   double  price[row_count]
+//   double  volume[row_count]
+//
+// The header also records the size, mtime and hash of the CSV the file was
+// built from, so it can serve as a cache that is rebuilt when the CSV changes.
+constexpr char kBinaryMarketDataMagic[8] = {'L', 'V', 'T', 'C', 'O', 'L', '0', '1'};
+constexpr uint32_t kBinaryMarketDataVersion = 1;
+
+struct BinaryMarketDataHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t header_size;
+  uint64_t row_count;
+  uint64_t source_size;
+  int64_t source_mtime_ns;
+  uint64_t source_hash;
+  uint64_t reserved[2];
+};
+static_assert(sizeof(BinaryMarketDataHeader) == 64, "header layout must stay fixed");
+
+// Identity of the CSV a binary file was converted from.
+struct SourceFileInfo {
+  uint64_t size = 0;
+  int64_t mtime_ns = 0;
+  uint64_t hash = 0;
+};
+
+// Fast 64-bit content hash used to detect CSV changes (not cryptographic).
+uint64_t HashBytes(std::string_view bytes);
+
+// Size and mtime of `path`; the hash is left at zero. Returns false if the
+// file cannot be stat'ed.
+bool StatSourceFile(const std::string& path, SourceFileInfo* info);
+
+// Sidecar cache location used for `csv_path`.
+std::string BinaryCachePath(const std::string& csv_path);
+
+// True if `path` starts with the binary format magic.
+bool IsBinaryMarketDataFile(const std::string& path);
+
+// Writes `data` in the binary format. The file is written under a temporary
+// name and renamed into place, so readers never see a partial file.
+bool WriteBinaryMarketData(const std::string& path, const MarketDataColumns& data,
+                           const SourceFileInfo& source);
+
+// Writes a binary file batch by batch when the row count is known up front,
+// so files larger than RAM can be produced. Each batch goes straight to its
+// final offset in the three columns. Like WriteBinaryMarketData(), the file
+// is built under a temporary name and renamed into place by Finish().
+class BinaryMarketDataWriter {
+ public:
+  BinaryMarketDataWriter();
+  BinaryMarketDataWriter(const BinaryMarketDataWriter&) = delete;
+  BinaryMarketDataWriter& operator=(const BinaryMarketDataWriter&) = delete;
+
+  bool Open(const std::string& path, uint64_t row_count,
+            const SourceFileInfo& source = SourceFileInfo());
+  // Returns false on I/O error or if the batch would exceed row_count.
+  bool Append(MarketDataView batch);
+  // Returns false (leaving no file) unless exactly row_count rows were appended.
+  bool Finish();
+
+ private:
+  // Removes the temporary file if Finish() was not reached.
+  AtomicFileWriter file_;
+  uint64_t row_count_;
+  uint64_t rows_written_;
+};
+
+// Reads the header of a binary file. Returns false if the file is missing,
+// has a different magic/version or its size does not match the row count.
+bool ReadBinaryMarketDataHeader(const std::string& path, BinaryMarketDataHeader* header);
+
+// Maps a binary file and points `out` at its columns (MarketDataColumns::
+// Borrow); nothing is parsed or copied, and the mapping stays open for as
+// long as `out` uses it.
+bool ReadBinaryMarketData(const std::string& path, MarketDataColumns* out,
+                          BinaryMarketDataHeader* header = nullptr);
+
+}  // namespace lvt
+
+#endif  // LARGE_VOLUME_TRADING_BINARY_MARKET_DATA_H_
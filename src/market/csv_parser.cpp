@@ -0,0 +1,107 @@
+#include "market/csv_parser.h"
+#include "market/timestamp.h"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <system_error>
+
+namespace lvt {
+
+namespace {
+
+bool IsSpace(char c) {
+  return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
+}
+
+bool ContainsToken(const char* begin, const char* end, std::string_view token) {
+  return std::string_view(begin, end - begin).find(token) != std::string_view::npos;
+}
+
+// Same acceptance rules as std::stod: leading whitespace and an explicit '+'
+// are allowed, trailing characters after the number are ignored.
+bool ParseDouble(const char* begin, const char* end, double* value) {
+  while (begin < end && IsSpace(*begin)) ++begin;
+  if (begin < end && *begin == '+') {
+    ++begin;
+    if (begin < end && *begin == '-') return false;
+  }
+  auto result = std::from_chars(begin, end, *value);
+  return result.ec == std::errc() && result.ptr != begin;
+}
+
+}  // namespace
+
+MarketDataCsvParser::MarketDataCsvParser() : header_skipped_(false) {}
+
+void MarketDataCsvParser::Reset() {
+  header_skipped_ = false;
+  stats_ = CsvParseStats();
+}
+
+void MarketDataCsvParser::Parse(std::string_view buffer, MarketDataColumns* out) {
+  size_t consumed = ParseLines(buffer, static_cast<size_t>(-1), out);
+  if (consumed < buffer.size()) ParseFinalLine(buffer.substr(consumed), out);
+}
+
+size_t MarketDataCsvParser::ParseLines(std::string_view buffer, size_t max_rows,
+                                       MarketDataColumns* out) {
+  const char* const start = buffer.data();
+  const char* const end = start + buffer.size();
+  const size_t target_rows = out->size() + std::min(max_rows, buffer.size());
+  const char* p = start;
+  while (p < end && out->size() < target_rows) {
+    const char* eol = static_cast<const char*>(std::memchr(p, '\n', end - p));
+    if (eol == nullptr) break;
+    ParseLine(p, eol, out);
+    p = eol + 1;
+  }
+  return static_cast<size_t>(p - start);
+}
+
+void MarketDataCsvParser::ParseFinalLine(std::string_view line, MarketDataColumns* out) {
+  ParseLine(line.data(), line.data() + line.size(), out);
+}
+
+void MarketDataCsvParser::ParseLine(const char* begin, const char* end,
+                                    MarketDataColumns* out) {
+  const char* first_non_space = begin;
+  while (first_non_space < end && IsSpace(*first_non_space)) ++first_non_space;
+  if (first_non_space == end) {
+    stats_.lines_skipped++;
+    return;
+  }
+  if (!header_skipped_ &&
+      (ContainsToken(begin, end, "timestamp") || ContainsToken(begin, end, "price"))) {
+    header_skipped_ = true;
+    stats_.lines_skipped++;
+    return;
+  }
+  const char* comma1 = static_cast<const char*>(std::memchr(begin, ',', end - begin));
+  if (comma1 == nullptr) {
+    stats_.lines_skipped++;
+    return;
+  }
+  const char* price_begin = comma1 + 1;
+  const char* comma2 = static_cast<const char*>(std::memchr(price_begin, ',', end - price_begin));
+  if (comma2 == nullptr) {
+    stats_.lines_skipped++;
+    return;
+  }
+  const char* volume_begin = comma2 + 1;
+  const char* volume_end = static_cast<const char*>(std::memchr(volume_begin, ',', end - volume_begin));
+  if (volume_end == nullptr) volume_end = end;
+
+  int64_t epoch_ns;
+  double price;
+  double volume;
+  if (!ParseTimestamp(std::string_view(begin, comma1 - begin), &epoch_ns) ||
+      !ParseDouble(price_begin, comma2, &price) ||
+      !ParseDouble(volume_begin, volume_end, &volume)) {
+    stats_.lines_skipped++;
+    return;
+  }
+  out->Append(epoch_ns, price, volume);
+  stats_.lines_processed++;
+}
+
+}  // namespace lvt
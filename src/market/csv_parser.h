@@ -0,0 +1,59 @@
+#ifndef LARGE_VOLUME_TRADING_CSV_PARSER_H_
+#define LARGE_VOLUME_TRADING_CSV_PARSER_H_
+
+#include <cstddef>
+#include <string_view>
+#include "market/market_data_columns.h"
+
+namespace lvt {
+
+// Line counters reported by the parser (and by MarketSimulator::Load).
+struct CsvParseStats {
+  size_t lines_processed = 0;
+  size_t lines_skipped = 0;
+};
+
+// Pointer-based tokenizer for "timestamp,price,volume" market data.
+// Scans a whole buffer in place and converts numbers with std::from_chars,
+// so no temporary strings are built per line.
+//
+// Skip rules match the original getline/stod loader:
+//  - blank or all-whitespace lines are skipped;
+//  - until a header has been seen, a line containing "timestamp" or "price"
+//    is treated as the header and skipped;
+//  - rows with fewer than three fields, an unparsable timestamp or an
+//    unparsable price/volume are skipped.
+//
+// The parser is stateful (header flag and counters), so a large file can be
+// fed chunk by chunk as long as every chunk ends on a line boundary.
+class MarketDataCsvParser {
+ public:
+  MarketDataCsvParser();
+
+  // Parses every line in `buffer` and appends valid rows to `out`.
+  // A trailing line without '\n' is parsed as a complete line.
+  void Parse(std::string_view buffer, MarketDataColumns* out);
+
+  // Parses only '\n'-terminated lines from the front of `buffer`, stopping
+  // once `max_rows` rows have been appended. Returns the number of bytes
+  // consumed; an incomplete trailing line is left for the next call.
+  size_t ParseLines(std::string_view buffer, size_t max_rows, MarketDataColumns* out);
+
+  // Parses `line` (without its '\n') as one complete line.
+  void ParseFinalLine(std::string_view line, MarketDataColumns* out);
+
+  // Forgets the header flag and zeroes the counters.
+  void Reset();
+
+  const CsvParseStats& stats() const { return stats_; }
+
+ private:
+  void ParseLine(const char* begin, const char* end, MarketDataColumns* out);
+
+  bool header_skipped_;
+  CsvParseStats stats_;
+};
+
+}  // namespace lvt
+
+#endif  // LARGE_VOLUME_TRADING_CSV_PARSER_H_
@@ -0,0 +1,53 @@
+#include "market/mapped_file.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define LVT_HAS_MMAP 1
+#endif
+
+namespace lvt {
+
+MappedFile::MappedFile() : data_(nullptr), size_(0) {}
+
+MappedFile::~MappedFile() {
+  Close();
+}
+
+bool MappedFile::Open(const std::string& path, bool sequential_hint) {
+  Close();
+#ifdef LVT_HAS_MMAP
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) return false;
+  struct stat st;
+  if (::fstat(fd, &st) != 0 || st.st_size <= 0) {
+    ::close(fd);
+    return false;
+  }
+  size_t size = static_cast<size_t>(st.st_size);
+  void* addr = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  // The mapping keeps its own reference to the file.
+  ::close(fd);
+  if (addr == MAP_FAILED) return false;
+  if (sequential_hint) ::madvise(addr, size, MADV_SEQUENTIAL);
+  data_ = static_cast<const char*>(addr);
+  size_ = size;
+  return true;
+#else
+  (void)path;
+  (void)sequential_hint;
+  return false;
+#endif
+}
+
+void MappedFile::Close() {
+#ifdef LVT_HAS_MMAP
+  if (data_ != nullptr) ::munmap(const_cast<char*>(data_), size_);
+#endif
+  data_ = nullptr;
+  size_ = 0;
+}
+
+}  // namespace lvt
@@ -0,0 +1,38 @@
+#ifndef LARGE_VOLUME_TRADING_MAPPED_FILE_H_
+#define LARGE_VOLUME_TRADING_MAPPED_FILE_H_
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace lvt {
+
+// Read-only memory mapping of a whole file (POSIX mmap). On platforms
+// without mmap Open() always fails and callers fall back to stream I/O.
+class MappedFile {
+ public:
+  MappedFile();
+  ~MappedFile();
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  // Maps `path` read-only. With `sequential_hint` the kernel is told the
+  // pages will be read front to back (madvise SEQUENTIAL), which enables
+  // aggressive read-ahead. Returns false if the file is missing, empty or
+  // cannot be mapped.
+  bool Open(const std::string& path, bool sequential_hint = false);
+  void Close();
+
+  bool is_open() const { return data_ != nullptr; }
+  const char* data() const { return data_; }
+  size_t size() const { return size_; }
+  std::string_view view() const { return std::string_view(data_, size_); }
+
+ private:
+  const char* data_;
+  size_t size_;
+};
+
+}  // namespace lvt
+
+#endif  // LARGE_VOLUME_TRADING_MAPPED_FILE_H_
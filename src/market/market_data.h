@@ -0,0 +1,18 @@
+#ifndef LARGE_VOLUME_TRADING_MARKET_DATA_H_
+#define LARGE_VOLUME_TRADING_MARKET_DATA_H_
+
+#include <cstdint>
+
+namespace lvt {
+
+// One bar. The timestamp is kept as nanoseconds since the Unix epoch (UTC);
+// use FormatTimestamp() from market/timestamp.h when text is needed.
+struct MarketData {
+  int64_t epoch_ns;
+  double price;
+  double volume;
+};
+
+}  // namespace lvt
+
+#endif  // LARGE_VOLUME_TRADING_MARKET_DATA_H_
@@ -0,0 +1,63 @@
+#include "market/market_data_columns.h"
+#include "market/timestamp.h"
+
+namespace lvt {
+
+MarketDataColumns::MarketDataColumns(std::initializer_list<MarketData> rows) {
+  Reserve(rows.size());
+  for (const auto& row : rows) Append(row);
+}
+
+void MarketDataColumns::Reserve(size_t n) {
+  Own();
+  price_.reserve(n);
+  volume_.reserve(n);
+  epoch_ns_.reserve(n);
+}
+
+void MarketDataColumns::Clear() {
+  backing_.reset();
+  price_.clear();
+  volume_.clear();
+  epoch_ns_.clear();
+}
+
+void MarketDataColumns::Append(int64_t epoch_ns, double price, double volume) {
+  if (backing_) Own();
+  epoch_ns_.push_back(epoch_ns);
+  price_.push_back(price);
+  volume_.push_back(volume);
+}
+
+void MarketDataColumns::Assign(std::span<const int64_t> epoch_ns, std::span<const double> price,
+                               std::span<const double> volume) {
+  backing_.reset();
+  epoch_ns_.assign(epoch_ns.begin(), epoch_ns.end());
+  price_.assign(price.begin(), price.end());
+  volume_.assign(volume.begin(), volume.end());
+}
+
+void MarketDataColumns::Borrow(std::shared_ptr<const void> backing, std::span<const int64_t> epoch_ns,
+                               std::span<const double> price, std::span<const double> volume) {
+  price_.clear();
+  volume_.clear();
+  epoch_ns_.clear();
+  backing_ = std::move(backing);
+  borrowed_epoch_ns_ = epoch_ns;
+  borrowed_price_ = price;
+  borrowed_volume_ = volume;
+}
+
+void MarketDataColumns::Own() {
+  if (!backing_) return;
+  epoch_ns_.assign(borrowed_epoch_ns_.begin(), borrowed_epoch_ns_.end());
+  price_.assign(borrowed_price_.begin(), borrowed_price_.end());
+  volume_.assign(borrowed_volume_.begin(), borrowed_volume_.end());
+  backing_.reset();
+}
+
+std::string MarketDataColumns::Timestamp(size_t i) const {
+  return FormatTimestamp(epoch_ns()[i]);
+}
+
+}  // namespace lvt
@@ -0,0 +1,109 @@
+#ifndef LARGE_VOLUME_TRADING_MARKET_DATA_COLUMNS_H_
+#define LARGE_VOLUME_TRADING_MARKET_DATA_COLUMNS_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+#include "market/market_data.h"
+
+namespace lvt {
+
+// Struct-of-arrays bar store: prices, volumes and epoch timestamps each live
+// in their own contiguous array, so a pass over one column touches only that
+// column. Timestamp text is formatted on demand by Timestamp().
+//
+// The columns can also borrow read-only memory owned by something else (a
+// mapped binary file, see Borrow()); they are then copied into owned
+// storage only if rows are appended later.
+class MarketDataColumns {
+ public:
+  MarketDataColumns() = default;
+  MarketDataColumns(std::initializer_list<MarketData> rows);
+
+  void Reserve(size_t n);
+  void Clear();
+  void Append(int64_t epoch_ns, double price, double volume);
+  void Append(const MarketData& row) { Append(row.epoch_ns, row.price, row.volume); }
+  // Replaces the contents with copies of whole columns (all the same length).
+  void Assign(std::span<const int64_t> epoch_ns, std::span<const double> price,
+              std::span<const double> volume);
+  // Replaces the contents with the given columns without copying them.
+  // `backing` owns their memory and is kept alive until the columns are
+  // cleared, reassigned or appended to.
+  void Borrow(std::shared_ptr<const void> backing, std::span<const int64_t> epoch_ns,
+              std::span<const double> price, std::span<const double> volume);
+  bool borrowed() const { return backing_ != nullptr; }
+
+  size_t size() const { return price().size(); }
+  bool empty() const { return size() == 0; }
+
+  std::span<const double> price() const {
+    return backing_ ? borrowed_price_ : std::span<const double>(price_);
+  }
+  std::span<const double> volume() const {
+    return backing_ ? borrowed_volume_ : std::span<const double>(volume_);
+  }
+  std::span<const int64_t> epoch_ns() const {
+    return backing_ ? borrowed_epoch_ns_ : std::span<const int64_t>(epoch_ns_);
+  }
+
+  // Row `i` gathered back into a MarketData.
+  MarketData Row(size_t i) const { return {epoch_ns()[i], price()[i], volume()[i]}; }
+
+  // ISO-8601 text of bar `i`, formatted from its epoch value.
+  std::string Timestamp(size_t i) const;
+
+ private:
+  // Copies borrowed columns into the owned vectors and drops the backing.
+  void Own();
+
+  std::vector<double> price_;
+  std::vector<double> volume_;
+  std::vector<int64_t> epoch_ns_;
+  std::shared_ptr<const void> backing_;
+  std::span<const double> borrowed_price_;
+  std::span<const double> borrowed_volume_;
+  std::span<const int64_t> borrowed_epoch_ns_;
+};
+
+// Non-owning view of a contiguous range of bars. Copying it is O(1); the
+// MarketDataColumns (or mapped file) it points into must outlive the view.
+// Converts implicitly from MarketDataColumns, the way std::span does from
+// std::vector, so strategies can take views without copying the store.
+class MarketDataView {
+ public:
+  MarketDataView() = default;
+  MarketDataView(const MarketDataColumns& columns)  // NOLINT(runtime/explicit)
+      : epoch_ns_(columns.epoch_ns()), price_(columns.price()), volume_(columns.volume()) {}
+  MarketDataView(std::span<const int64_t> epoch_ns, std::span<const double> price,
+                 std::span<const double> volume)
+      : epoch_ns_(epoch_ns), price_(price), volume_(volume) {}
+
+  size_t size() const { return price_.size(); }
+  bool empty() const { return price_.empty(); }
+
+  std::span<const double> price() const { return price_; }
+  std::span<const double> volume() const { return volume_; }
+  std::span<const int64_t> epoch_ns() const { return epoch_ns_; }
+
+  MarketData Row(size_t i) const { return {epoch_ns_[i], price_[i], volume_[i]}; }
+
+  // Bars [offset, offset + count).
+  MarketDataView subview(size_t offset, size_t count) const {
+    return MarketDataView(epoch_ns_.subspan(offset, count), price_.subspan(offset, count),
+                          volume_.subspan(offset, count));
+  }
+
+ private:
+  std::span<const int64_t> epoch_ns_;
+  std::span<const double> price_;
+  std::span<const double> volume_;
+};
+
+}  // namespace lvt
+
+#endif  // LARGE_VOLUME_TRADING_MARKET_DATA_COLUMNS_H_
@@ -0,0 +1,120 @@
+#include "market/market_data_reader.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include "market/binary_market_data.h"
+
+namespace lvt {
+
+namespace {
+
+constexpr size_t kReadChunkBytes = 4 << 20;
+
+}  // namespace
+
+MarketDataReader::MarketDataReader(const std::string& path, size_t batch_size)
+    : path_(path),
+      batch_size_(batch_size > 0 ? batch_size : 1),
+      opened_(false),
+      binary_offset_(0),
+      buffer_begin_(0),
+      buffer_end_(0),
+      eof_(false) {}
+
+bool MarketDataReader::Open() {
+  opened_ = false;
+  mapped_.Close();
+  binary_data_ = MarketDataView();
+  binary_offset_ = 0;
+  file_.close();
+  file_.clear();
+  buffer_begin_ = buffer_end_ = 0;
+  eof_ = false;
+  parser_.Reset();
+
+  if (IsBinaryMarketDataFile(path_)) {
+    BinaryMarketDataHeader header;
+    if (!ReadBinaryMarketDataHeader(path_, &header) ||
+        !mapped_.Open(path_, /*sequential_hint=*/true)) {
+      std::cerr << "[Error] Invalid binary market data file: " << path_ << std::endl;
+      return false;
+    }
+    const size_t n = header.row_count;
+    const char* columns = mapped_.data() + header.header_size;
+    binary_data_ = MarketDataView(
+        {reinterpret_cast<const int64_t*>(columns), n},
+        {reinterpret_cast<const double*>(columns + n * sizeof(int64_t)), n},
+        {reinterpret_cast<const double*>(columns + n * (sizeof(int64_t) + sizeof(double))), n});
+    opened_ = true;
+    return true;
+  }
+
+  file_.open(path_, std::ios::binary);
+  if (!file_.is_open()) {
+    std::cerr << "[Error] Cannot open file: " << path_ << std::endl;
+    return false;
+  }
+  if (buffer_.size() < kReadChunkBytes) buffer_.resize(kReadChunkBytes);
+  batch_.Reserve(batch_size_);
+  opened_ = true;
+  return true;
+}
+
+bool MarketDataReader::FillBuffer() {
+  // Move the unconsumed tail to the front; grow only when a single line
+  // does not fit in the buffer.
+  const size_t pending = buffer_end_ - buffer_begin_;
+  if (buffer_begin_ > 0) {
+    std::memmove(buffer_.data(), buffer_.data() + buffer_begin_, pending);
+    buffer_begin_ = 0;
+    buffer_end_ = pending;
+  }
+  if (buffer_end_ == buffer_.size()) buffer_.resize(buffer_.size() * 2);
+  file_.read(buffer_.data() + buffer_end_, buffer_.size() - buffer_end_);
+  const size_t got = static_cast<size_t>(file_.gcount());
+  buffer_end_ += got;
+  if (got == 0 || file_.eof()) eof_ = true;
+  return got > 0;
+}
+
+bool MarketDataReader::Next(MarketDataView* batch) {
+  if (!opened_) return false;
+
+  if (mapped_.is_open()) {
+    if (binary_offset_ >= binary_data_.size()) return false;
+    const size_t count = std::min(batch_size_, binary_data_.size() - binary_offset_);
+    *batch = binary_data_.subview(binary_offset_, count);
+    binary_offset_ += count;
+    return true;
+  }
+
+  batch_.Clear();
+  while (batch_.size() < batch_size_) {
+    std::string_view pending(buffer_.data() + buffer_begin_, buffer_end_ - buffer_begin_);
+    buffer_begin_ += parser_.ParseLines(pending, batch_size_ - batch_.size(), &batch_);
+    if (batch_.size() >= batch_size_) break;
+    if (eof_) {
+      if (buffer_begin_ < buffer_end_) {
+        parser_.ParseFinalLine(
+            std::string_view(buffer_.data() + buffer_begin_, buffer_end_ - buffer_begin_), &batch_);
+        buffer_begin_ = buffer_end_;
+      }
+      break;
+    }
+    FillBuffer();
+  }
+  if (batch_.empty()) return false;
+  *batch = batch_;
+  return true;
+}
+
+bool MarketDataReader::ForEachBatch(const std::function<bool(MarketDataView)>& fn) {
+  if (!opened_ && !Open()) return false;
+  MarketDataView batch;
+  while (Next(&batch)) {
+    if (!fn(batch)) break;
+  }
+  return true;
+}
+
+}  // namespace lvt
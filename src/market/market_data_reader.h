@@ -0,0 +1,67 @@
+#ifndef LARGE_VOLUME_TRADING_MARKET_DATA_READER_H_
+#define LARGE_VOLUME_TRADING_MARKET_DATA_READER_H_
+
+#include <cstddef>
+#include <fstream>
+#include <functional>
+#include <string>
+#include "market/csv_parser.h"
+#include "market/mapped_file.h"
+#include "market/market_data_columns.h"
+
+namespace lvt {
+
+// Streams a market data file as fixed-size batches of bars, so files larger
+// than RAM can be processed. Memory use is one read chunk plus one batch,
+// independent of the file size.
+//
+// CSV input is read in chunks and parsed with the same rules as
+// MarketSimulator::Load. Binary columnar files (market/binary_market_data.h)
+// are mapped and handed out as views into the mapping without copying.
+class MarketDataReader {
+ public:
+  static constexpr size_t kDefaultBatchSize = 64 * 1024;
+
+  explicit MarketDataReader(const std::string& path, size_t batch_size = kDefaultBatchSize);
+  MarketDataReader(const MarketDataReader&) = delete;
+  MarketDataReader& operator=(const MarketDataReader&) = delete;
+
+  // Opens the file (or reopens it from the start). Returns false on I/O error.
+  bool Open();
+
+  // Fetches the next batch of at most batch_size bars. Returns false once the
+  // input is exhausted. `batch` stays valid until the next call.
+  bool Next(MarketDataView* batch);
+
+  // Calls `fn` for every remaining batch; stops early if `fn` returns false.
+  // Returns false if the reader could not be opened.
+  bool ForEachBatch(const std::function<bool(MarketDataView)>& fn);
+
+  // Line counters for the CSV consumed so far.
+  const CsvParseStats& stats() const { return parser_.stats(); }
+
+ private:
+  bool FillBuffer();
+
+  std::string path_;
+  size_t batch_size_;
+  bool opened_;
+
+  // Binary input.
+  MappedFile mapped_;
+  MarketDataView binary_data_;
+  size_t binary_offset_;
+
+  // CSV input.
+  std::ifstream file_;
+  std::string buffer_;
+  size_t buffer_begin_;
+  size_t buffer_end_;
+  bool eof_;
+  MarketDataCsvParser parser_;
+  MarketDataColumns batch_;
+};
+
+}  // namespace lvt
+
+#endif  // LARGE_VOLUME_TRADING_MARKET_DATA_READER_H_
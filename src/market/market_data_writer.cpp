@@ -0,0 +1,60 @@
+#include "market/market_data_writer.h"
+#include <charconv>
+#include "market/timestamp.h"
+
+namespace lvt {
+
+namespace {
+
+// Longest row: timestamp, two shortest-form doubles (at most 24 chars
+// each), two commas and the newline.
+constexpr size_t kMaxRowLength = kMaxTimestampLength + 2 * 24 + 3;
+
+}  // namespace
+
+MarketDataCsvWriter::MarketDataCsvWriter() : bytes_written_(0) {}
+
+bool MarketDataCsvWriter::Open(const std::string& path) {
+  bytes_written_ = 0;
+  buffer_.clear();
+  buffer_.reserve(kFlushBytes + kMaxRowLength);
+  if (!file_.Open(path)) return false;
+  buffer_ = "timestamp,price,volume\n";
+  return true;
+}
+
+bool MarketDataCsvWriter::Append(MarketDataView batch) {
+  if (!file_.is_open()) return false;
+  const auto epoch_ns = batch.epoch_ns();
+  const auto price = batch.price();
+  const auto volume = batch.volume();
+  char row[kMaxRowLength];
+  for (size_t i = 0; i < batch.size(); ++i) {
+    char* p = row + FormatTimestamp(epoch_ns[i], row);
+    *p++ = ',';
+    p = std::to_chars(p, row + sizeof(row), price[i]).ptr;
+    *p++ = ',';
+    p = std::to_chars(p, row + sizeof(row), volume[i]).ptr;
+    *p++ = '\n';
+    buffer_.append(row, p - row);
+    if (buffer_.size() >= kFlushBytes && !Flush()) return false;
+  }
+  return true;
+}
+
+bool MarketDataCsvWriter::Finish() {
+  if (!file_.is_open() || !Flush()) {
+    file_.Abandon();
+    return false;
+  }
+  return file_.Commit();
+}
+
+bool MarketDataCsvWriter::Flush() {
+  const bool ok = file_.Write(buffer_.data(), buffer_.size());
+  bytes_written_ += buffer_.size();
+  buffer_.clear();
+  return ok;
+}
+
+}  // namespace lvt
@@ -0,0 +1,43 @@
+#ifndef LARGE_VOLUME_TRADING_MARKET_DATA_WRITER_H_
+#define LARGE_VOLUME_TRADING_MARKET_DATA_WRITER_H_
+
+#include <cstddef>
+#include <string>
+#include "market/market_data_columns.h"
+#include "util/atomic_file_writer.h"
+
+namespace lvt {
+
+// Writes bars as "timestamp,price,volume" CSV, the input format of
+// MarketSimulator. Rows are formatted with std::to_chars (shortest
+// round-trip form) into a buffer that is flushed in large blocks, so output
+// runs at close to disk speed. Like BinaryMarketDataWriter, the file is
+// written under a temporary name and renamed into place by Finish().
+class MarketDataCsvWriter {
+ public:
+  static constexpr size_t kFlushBytes = 1 << 20;
+
+  MarketDataCsvWriter();
+  MarketDataCsvWriter(const MarketDataCsvWriter&) = delete;
+  MarketDataCsvWriter& operator=(const MarketDataCsvWriter&) = delete;
+
+  // Creates the file and writes the header line.
+  bool Open(const std::string& path);
+  bool Append(MarketDataView batch);
+  bool Finish();
+
+  // Bytes produced so far, including the header.
+  size_t bytes_written() const { return bytes_written_ + buffer_.size(); }
+
+ private:
+  bool Flush();
+
+  // Removes the temporary file if Finish() was not reached.
+  AtomicFileWriter file_;
+  std::string buffer_;
+  size_t bytes_written_;
+};
+
+}  // namespace lvt
+
+#endif  // LARGE_VOLUME_TRADING_MARKET_DATA_WRITER_H_
@@ -1,69 +1,186 @@
 #include "market/market_simulator.h"
+#include "market/binary_market_data.h"
+#include "market/mapped_file.h"
+#include "market/timestamp.h"
+#include "util/instrumentation.h"
 #include <fstream>
-#include <sstream>
 #include <algorithm>
 #include <iostream>
 
 namespace lvt {
 
-MarketSimulator::MarketSimulator(const std::string& csv_file_path) : csv_file_path_(csv_file_path) {}
+namespace {
 
-// I had to debug this function because I had missed a couple of lines,
-// so it looks a bit bloated and I have to remove half of the code
-// from it, really
-bool MarketSimulator::Load() {
-  market_data_.clear();
-  std::ifstream file(csv_file_path_);
+bool ReadWholeFile(const std::string& path, std::string* buffer) {
+  std::ifstream file(path, std::ios::binary);
   if (!file.is_open()) {
+    std::cerr << "[Error] Cannot open file: " << path << std::endl;
+    return false;
+  }
+  file.seekg(0, std::ios::end);
+  std::streamoff size = file.tellg();
+  file.seekg(0, std::ios::beg);
+  buffer->assign(size > 0 ? static_cast<size_t>(size) : 0, '\0');
+  if (!buffer->empty() && !file.read(buffer->data(), size)) {
+    std::cerr << "[Error] Cannot read file: " << path << std::endl;
+    return false;
+  }
+  return true;
+}
+
+// Rows in `buffer`, extrapolated from the line length of its first 64 KB
+// with a 10% margin, so sizing the columns does not cost a second pass over
+// a large file. A short estimate only means the columns grow geometrically.
+size_t EstimateRowCount(std::string_view buffer) {
+  constexpr size_t kSampleBytes = 64 << 10;
+  const std::string_view sample = buffer.substr(0, kSampleBytes);
+  const size_t lines = static_cast<size_t>(std::count(sample.begin(), sample.end(), '\n')) + 1;
+  if (sample.size() == buffer.size()) return lines;
+  return static_cast<size_t>(1.1 * static_cast<double>(buffer.size()) / sample.size() * lines);
+}
+
+}  // namespace
+
+MarketSimulator::MarketSimulator(const std::string& csv_file_path) : csv_file_path_(csv_file_path) {}
+
+bool MarketSimulator::Load(LoadMode mode) {
+  LVT_STAGE_TIMER(Stage::kLoad);
+  market_data_.Clear();
+  load_stats_ = CsvParseStats();
+  day_index_.Clear();
+  if (!LoadData(mode)) return false;
+  if (!day_index_.Build(market_data_.epoch_ns())) {
+    std::cerr << "[Warning] Bars in " << csv_file_path_
+              << " are not in time order; day lookups are unavailable" << std::endl;
+  }
+  return true;
+}
+
+bool MarketSimulator::LoadData(LoadMode mode) {
+  if (IsBinaryMarketDataFile(csv_file_path_)) return LoadBinary(csv_file_path_);
+  if (mode == LoadMode::kCached) return LoadCached();
+  if (mode == LoadMode::kMmap) {
+    MappedFile file;
+    if (file.Open(csv_file_path_, /*sequential_hint=*/true)) return ParseBuffer(file.view());
+    std::cerr << "[Warning] Cannot map " << csv_file_path_
+              << ", falling back to stream loading" << std::endl;
+  }
+  return LoadFromStream();
+}
+
+bool MarketSimulator::LoadFromStream() {
+  std::string buffer;
+  return ReadWholeFile(csv_file_path_, &buffer) && ParseBuffer(buffer);
+}
+
+bool MarketSimulator::LoadBinary(const std::string& path) {
+  if (!ReadBinaryMarketData(path, &market_data_)) {
+    std::cerr << "[Error] Invalid binary market data file: " << path << std::endl;
+    return false;
+  }
+  load_stats_.lines_processed = market_data_.size();
+  if (market_data_.empty()) {
+    std::cerr << "[Error] No valid data loaded from " << path << std::endl;
+    return false;
+  }
+  return true;
+}
+
+bool MarketSimulator::LoadCached() {
+  SourceFileInfo source;
+  if (!StatSourceFile(csv_file_path_, &source)) {
     std::cerr << "[Error] Cannot open file: " << csv_file_path_ << std::endl;
     return false;
   }
-  std::string line;
-  bool header_skipped = false;
-  int lines_processed = 0;
-  int lines_skipped = 0;
-  while (std::getline(file, line)) {
-    // Skip blank or all-whitespace lines
-    if (line.empty() || std::all_of(line.begin(), line.end(), isspace)) {
-      lines_skipped++;
-      continue;
-    }
-    // Skip CSV header (first non-blank line containing "timestamp" or "price")
-    if (!header_skipped && (
-         line.find("timestamp") != std::string::npos ||
-         line.find("price") != std::string::npos)) {
-      header_skipped = true;
-      lines_skipped++;
-      continue;
-    }
-    std::istringstream iss(line);
-    std::string timestamp, price_str, volume_str;
-    if (std::getline(iss, timestamp, ',') &&
-        std::getline(iss, price_str, ',') &&
-        std::getline(iss, volume_str, ',')) {
-      try {
-        MarketData data = {timestamp, std::stod(price_str), std::stod(volume_str)};
-        market_data_.push_back(data);
-        lines_processed++;
-      } catch (const std::exception& e) {
-        lines_skipped++;
-        continue;
-      }
-    } else {
-      lines_skipped++;
-    }
+  const std::string cache_path = BinaryCachePath(csv_file_path_);
+  BinaryMarketDataHeader header;
+  const bool have_cache = ReadBinaryMarketDataHeader(cache_path, &header) &&
+                          header.source_size == source.size;
+  if (have_cache && header.source_mtime_ns == source.mtime_ns && LoadBinary(cache_path)) {
+    return true;
+  }
+
+  // Cache missing or stale by mtime: read the CSV once. If only the mtime
+  // moved (same content hash) the cached columns are still good.
+  MappedFile mapped;
+  std::string buffer;
+  std::string_view csv;
+  if (mapped.Open(csv_file_path_, /*sequential_hint=*/true)) {
+    csv = mapped.view();
+  } else {
+    if (!ReadWholeFile(csv_file_path_, &buffer)) return false;
+    csv = buffer;
   }
+  source.hash = HashBytes(csv);
+  const bool content_unchanged = have_cache && header.source_hash == source.hash &&
+                                 ReadBinaryMarketData(cache_path, &market_data_) &&
+                                 !market_data_.empty();
+  if (content_unchanged) {
+    load_stats_.lines_processed = market_data_.size();
+  } else if (!ParseBuffer(csv)) {
+    return false;
+  }
+  if (!WriteBinaryMarketData(cache_path, market_data_, source)) {
+    std::cerr << "[Warning] Cannot write cache file: " << cache_path << std::endl;
+  }
+  return true;
+}
+
+bool MarketSimulator::ParseBuffer(std::string_view buffer) {
+  LVT_STAGE_TIMER(Stage::kParse);
+  market_data_.Reserve(EstimateRowCount(buffer));
+  MarketDataCsvParser parser;
+  parser.Parse(buffer, &market_data_);
+  load_stats_ = parser.stats();
   if (market_data_.empty()) {
-    std::cerr << "[Error] No valid data loaded. Processed: " << lines_processed 
-              << ", Skipped: " << lines_skipped << std::endl;
+    std::cerr << "[Error] No valid data loaded. Processed: " << load_stats_.lines_processed
+              << ", Skipped: " << load_stats_.lines_skipped << std::endl;
     return false;
   }
   return true;
 }
 
-const std::vector<MarketData>& MarketSimulator::GetMarketData() const {
+const MarketDataColumns& MarketSimulator::GetMarketData() const {
   return market_data_;
 }
 
+const CsvParseStats& MarketSimulator::GetLoadStats() const {
+  return load_stats_;
+}
+
+const TradingDayIndex& MarketSimulator::GetDayIndex() const {
+  return day_index_;
+}
+
+MarketDataView MarketSimulator::GetTradingDay(size_t day_index) const {
+  if (day_index >= day_index_.day_count()) return MarketDataView();
+  const size_t begin = day_index_.begin(day_index);
+  return MarketDataView(market_data_).subview(begin, day_index_.end(day_index) - begin);
+}
+
+MarketDataView MarketSimulator::GetFirstSession() const {
+  if (day_index_.day_count() > 0) return GetTradingDay(0);
+  const auto epoch_ns = market_data_.epoch_ns();
+  if (epoch_ns.empty()) return MarketDataView();
+  const int64_t first_day = EpochDay(epoch_ns[0]);
+  size_t bars = 1;
+  while (bars < epoch_ns.size() && EpochDay(epoch_ns[bars]) == first_day) ++bars;
+  return MarketDataView(market_data_).subview(0, bars);
+}
+
+MarketDataView MarketSimulator::GetBarsForDay(int64_t epoch_day) const {
+  const size_t i = day_index_.Find(epoch_day);
+  return i == TradingDayIndex::kNotFound ? MarketDataView() : GetTradingDay(i);
+}
+
+MarketDataView MarketSimulator::GetBarsInWindow(int64_t start_ns, int64_t end_ns) const {
+  const auto epoch_ns = market_data_.epoch_ns();
+  if (day_index_.day_count() == 0 || end_ns <= start_ns) return MarketDataView();
+  const auto first = std::lower_bound(epoch_ns.begin(), epoch_ns.end(), start_ns);
+  const auto last = std::lower_bound(first, epoch_ns.end(), end_ns);
+  return MarketDataView(market_data_)
+      .subview(static_cast<size_t>(first - epoch_ns.begin()), static_cast<size_t>(last - first));
+}
+
 }  // namespace lvt
 
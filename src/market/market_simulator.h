@@ -2,25 +2,57 @@
 #define LARGE_VOLUME_TRADING_MARKET_SIMULATOR_H_
 
 #include <string>
-#include <vector>
+#include <string_view>
+#include "market/csv_parser.h"
+#include "market/market_data_columns.h"
+#include "market/trading_day_index.h"
 
 namespace lvt {
 
-struct MarketData {
-  std::string timestamp;
-  double price;
-  double volume;
+// How Load() gets the file contents into memory.
+enum class LoadMode {
+  kStream,  // Read the file through std::ifstream into a buffer.
+  kMmap,    // Parse straight out of a read-only mapping; falls back to kStream.
+  kCached,  // Use the binary sidecar cache (<csv>.lvtc), rebuilding it when
+            // the CSV's size, mtime or content hash no longer match.
 };
 
 class MarketSimulator {
  public:
   explicit MarketSimulator(const std::string& csv_file_path);
-  bool Load();
-  const std::vector<MarketData>& GetMarketData() const;
+  // Loads the input file. Files in the binary columnar format (see
+  // market/binary_market_data.h) are detected by their magic and mapped
+  // directly whatever the mode.
+  bool Load(LoadMode mode = LoadMode::kStream);
+  const MarketDataColumns& GetMarketData() const;
+
+  // Per-day offsets built at load time (empty if the bars are not time-sorted).
+  const TradingDayIndex& GetDayIndex() const;
+  // Bars of the i-th trading day in the file.
+  MarketDataView GetTradingDay(size_t day_index) const;
+  // Bars of the first trading day. Unlike GetTradingDay(0) this also works
+  // without a day index (bars not in time order): it is then the leading
+  // run of bars on the first bar's UTC day.
+  MarketDataView GetFirstSession() const;
+  // Bars of UTC day `epoch_day` (see EpochDay()); empty if there are none.
+  MarketDataView GetBarsForDay(int64_t epoch_day) const;
+  // Bars with start_ns <= timestamp < end_ns, found by binary search.
+  MarketDataView GetBarsInWindow(int64_t start_ns, int64_t end_ns) const;
+
+  // Line counters from the most recent Load().
+  const CsvParseStats& GetLoadStats() const;
 
  private:
+  bool LoadData(LoadMode mode);
+  bool LoadFromStream();
+  bool LoadBinary(const std::string& path);
+  bool LoadCached();
+  bool ParseBuffer(std::string_view buffer);
+
   std::string csv_file_path_;
-  std::vector<MarketData> market_data_;
+  MarketDataColumns market_data_;
+  CsvParseStats load_stats_;
+  TradingDayIndex day_index_;
 };
 
 }  // namespace lvt
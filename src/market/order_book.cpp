@@ -0,0 +1,206 @@
+#include "market/order_book.h"
+#include <algorithm>
+#include <iostream>
+
+namespace lvt {
+
+OrderBook::OrderBook(int64_t min_tick, size_t levels, size_t capacity)
+    : min_tick_(min_tick),
+      levels_(levels),
+      bids_(levels),
+      asks_(levels),
+      nodes_(std::min<size_t>(capacity, kNil)) {
+  Clear();
+}
+
+void OrderBook::Clear() {
+  std::fill(bids_.begin(), bids_.end(), Level());
+  std::fill(asks_.begin(), asks_.end(), Level());
+  // Generations survive a Clear so that old handles stay stale.
+  for (size_t i = 0; i < nodes_.size(); ++i) {
+    if (nodes_[i].live) nodes_[i].generation++;
+    nodes_[i].live = false;
+    nodes_[i].next = i + 1 < nodes_.size() ? static_cast<uint32_t>(i + 1) : kNil;
+  }
+  free_head_ = nodes_.empty() ? kNil : 0;
+  order_count_ = 0;
+  best_bid_ = -1;
+  best_ask_ = static_cast<int64_t>(levels_);
+}
+
+OrderId OrderBook::AddLimit(Side side, int64_t price, double quantity, double* filled) {
+  if (filled) *filled = 0.0;
+  const int64_t level = price - min_tick_;
+  if (level < 0 || level >= static_cast<int64_t>(levels_)) {
+    std::cerr << "[Error] Order price " << price << " is outside the book's tick range" << std::endl;
+    return kNoOrder;
+  }
+  if (!(quantity > 0)) {
+    std::cerr << "[Error] Order quantity must be positive" << std::endl;
+    return kNoOrder;
+  }
+
+  const double remaining = Match(side, level, quantity);
+  if (filled) *filled = quantity - remaining;
+  if (remaining <= 0) return kNoOrder;
+  if (free_head_ == kNil) {
+    std::cerr << "[Error] Order book is full (" << nodes_.size() << " orders)" << std::endl;
+    return kNoOrder;
+  }
+
+  const uint32_t slot = free_head_;
+  Node& node = nodes_[slot];
+  free_head_ = node.next;
+  Level& lvl = LevelsFor(side)[level];
+  node.quantity = remaining;
+  node.prev = lvl.tail;
+  node.next = kNil;
+  node.level = static_cast<uint32_t>(level);
+  node.side = side;
+  node.live = true;
+  if (lvl.tail == kNil) {
+    lvl.head = slot;
+  } else {
+    nodes_[lvl.tail].next = slot;
+  }
+  lvl.tail = slot;
+  lvl.count++;
+  lvl.quantity += remaining;
+  order_count_++;
+  if (side == Side::kBuy) {
+    best_bid_ = std::max(best_bid_, level);
+  } else {
+    best_ask_ = std::min(best_ask_, level);
+  }
+  return (static_cast<OrderId>(node.generation) << 32) | slot;
+}
+
+double OrderBook::ExecuteMarket(Side side, double quantity) {
+  if (!(quantity > 0)) return 0.0;
+  const int64_t limit = side == Side::kBuy ? static_cast<int64_t>(levels_) - 1 : 0;
+  return quantity - Match(side, limit, quantity);
+}
+
+double OrderBook::Match(Side side, int64_t limit_level, double quantity) {
+  const bool buy = side == Side::kBuy;
+  std::vector<Level>& book = buy ? asks_ : bids_;
+  int64_t& best = buy ? best_ask_ : best_bid_;
+  const int64_t end = buy ? static_cast<int64_t>(levels_) : -1;
+  const int64_t step = buy ? 1 : -1;
+
+  while (quantity > 0 && best != end && (buy ? best <= limit_level : best >= limit_level)) {
+    Level& lvl = book[best];
+    while (quantity > 0 && lvl.head != kNil) {
+      const uint32_t slot = lvl.head;
+      Node& node = nodes_[slot];
+      if (node.quantity > quantity) {
+        node.quantity -= quantity;
+        lvl.quantity -= quantity;
+        quantity = 0;
+        break;
+      }
+      quantity -= node.quantity;
+      lvl.head = node.next;
+      if (lvl.head == kNil) {
+        lvl.tail = kNil;
+      } else {
+        nodes_[lvl.head].prev = kNil;
+      }
+      lvl.count--;
+      lvl.quantity -= node.quantity;
+      Release(slot);
+    }
+    if (lvl.head != kNil) break;
+    lvl.quantity = 0.0;  // Drop rounding residue from the running sum.
+    while (best != end && book[best].head == kNil) best += step;
+  }
+  return quantity;
+}
+
+bool OrderBook::Cancel(OrderId id) {
+  const uint32_t slot = Find(id);
+  if (slot == kNil) return false;
+  Unlink(slot);
+  Release(slot);
+  return true;
+}
+
+bool OrderBook::Reduce(OrderId id, double quantity) {
+  const uint32_t slot = Find(id);
+  if (slot == kNil) return false;
+  Node& node = nodes_[slot];
+  if (!(quantity > 0) || quantity > node.quantity) return false;
+  LevelsFor(node.side)[node.level].quantity -= node.quantity - quantity;
+  node.quantity = quantity;
+  return true;
+}
+
+double OrderBook::DepthAt(Side side, int64_t price) const {
+  const int64_t level = price - min_tick_;
+  if (level < 0 || level >= static_cast<int64_t>(levels_)) return 0.0;
+  return LevelsFor(side)[level].quantity;
+}
+
+size_t OrderBook::OrdersAt(Side side, int64_t price) const {
+  const int64_t level = price - min_tick_;
+  if (level < 0 || level >= static_cast<int64_t>(levels_)) return 0;
+  return LevelsFor(side)[level].count;
+}
+
+double OrderBook::RemainingQuantity(OrderId id) const {
+  const uint32_t slot = Find(id);
+  return slot == kNil ? 0.0 : nodes_[slot].quantity;
+}
+
+double OrderBook::QueueAhead(OrderId id) const {
+  const uint32_t slot = Find(id);
+  if (slot == kNil) return -1.0;
+  double ahead = 0.0;
+  for (uint32_t i = nodes_[slot].prev; i != kNil; i = nodes_[i].prev) ahead += nodes_[i].quantity;
+  return ahead;
+}
+
+uint32_t OrderBook::Find(OrderId id) const {
+  const uint64_t slot = id & 0xffffffffu;
+  if (slot >= nodes_.size()) return kNil;
+  const Node& node = nodes_[slot];
+  if (!node.live || node.generation != static_cast<uint32_t>(id >> 32)) return kNil;
+  return static_cast<uint32_t>(slot);
+}
+
+void OrderBook::Unlink(uint32_t slot) {
+  Node& node = nodes_[slot];
+  Level& lvl = LevelsFor(node.side)[node.level];
+  if (node.prev == kNil) {
+    lvl.head = node.next;
+  } else {
+    nodes_[node.prev].next = node.next;
+  }
+  if (node.next == kNil) {
+    lvl.tail = node.prev;
+  } else {
+    nodes_[node.next].prev = node.prev;
+  }
+  lvl.count--;
+  lvl.quantity -= node.quantity;
+  if (lvl.head != kNil) return;
+
+  lvl.quantity = 0.0;
+  const int64_t level = node.level;
+  if (node.side == Side::kBuy && level == best_bid_) {
+    while (best_bid_ >= 0 && bids_[best_bid_].head == kNil) --best_bid_;
+  } else if (node.side == Side::kSell && level == best_ask_) {
+    while (best_ask_ < static_cast<int64_t>(levels_) && asks_[best_ask_].head == kNil) ++best_ask_;
+  }
+}
+
+void OrderBook::Release(uint32_t slot) {
+  Node& node = nodes_[slot];
+  node.live = false;
+  node.generation++;
+  node.next = free_head_;
+  free_head_ = slot;
+  order_count_--;
+}
+
+}  // namespace lvt
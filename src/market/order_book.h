@@ -0,0 +1,116 @@
+#ifndef LARGE_VOLUME_TRADING_ORDER_BOOK_H_
+#define LARGE_VOLUME_TRADING_ORDER_BOOK_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace lvt {
+
+enum class Side { kBuy, kSell };
+
+// Handle of a resting order: pool slot in the low 32 bits, the slot's reuse
+// generation in the high 32 bits, so a handle to a filled or cancelled order
+// never aliases a newer order in the same slot.
+using OrderId = uint64_t;
+constexpr OrderId kNoOrder = ~OrderId{0};
+
+// Simulated price-time priority book over a fixed band of integer price
+// ticks. Each side is a flat array of levels indexed by tick - min_tick, and
+// every level holds an intrusive doubly-linked FIFO of order nodes taken from
+// a preallocated pool, so adds, cancels and fills never allocate and touch
+// only a few cache lines. Best prices are tracked by index and rescanned
+// over the flat arrays when their level empties.
+class OrderBook {
+ public:
+  // Prices are in ticks within [min_tick, min_tick + levels); at most
+  // `capacity` orders can rest at once.
+  OrderBook(int64_t min_tick, size_t levels, size_t capacity);
+
+  // Removes every order.
+  void Clear();
+
+  // Matches the order against the opposite side up to `price`, then rests
+  // the remainder. Returns the resting order's id, or kNoOrder if it filled
+  // completely or was rejected (error message: price outside the band, full
+  // pool, or non-positive quantity). `filled` receives the matched quantity.
+  OrderId AddLimit(Side side, int64_t price, double quantity, double* filled = nullptr);
+  // Takes liquidity from the opposite side until `quantity` is filled or the
+  // side is empty. Returns the filled quantity.
+  double ExecuteMarket(Side side, double quantity);
+  // Removes a resting order. Returns false if it is no longer in the book.
+  bool Cancel(OrderId id);
+  // Lowers a resting order's quantity, keeping its queue position.
+  // Returns false if it is no longer in the book or `quantity` is not in
+  // (0, current quantity].
+  bool Reduce(OrderId id, double quantity);
+
+  // Best prices in ticks; best_bid() < min_tick and best_ask() >= min_tick +
+  // levels when that side is empty.
+  int64_t best_bid() const { return min_tick_ + best_bid_; }
+  int64_t best_ask() const { return min_tick_ + best_ask_; }
+  bool HasBid() const { return best_bid_ >= 0; }
+  bool HasAsk() const { return best_ask_ < static_cast<int64_t>(levels_); }
+
+  // Resting quantity and order count at a price (0 outside the band).
+  double DepthAt(Side side, int64_t price) const;
+  size_t OrdersAt(Side side, int64_t price) const;
+
+  // Remaining quantity of a resting order; 0 once it has filled or been
+  // cancelled.
+  double RemainingQuantity(OrderId id) const;
+  // Quantity queued ahead of a resting order at its level (its queue
+  // position); -1 if it is no longer in the book.
+  double QueueAhead(OrderId id) const;
+
+  size_t order_count() const { return order_count_; }
+  size_t capacity() const { return nodes_.size(); }
+  int64_t min_tick() const { return min_tick_; }
+  size_t levels() const { return levels_; }
+
+ private:
+  static constexpr uint32_t kNil = ~uint32_t{0};
+
+  struct Level {
+    double quantity = 0.0;
+    uint32_t head = kNil;
+    uint32_t tail = kNil;
+    uint32_t count = 0;
+  };
+
+  struct Node {
+    double quantity;
+    uint32_t prev;
+    uint32_t next;  // Also links the free list.
+    uint32_t level;
+    uint32_t generation;
+    Side side;
+    bool live;
+  };
+
+  std::vector<Level>& LevelsFor(Side side) { return side == Side::kBuy ? bids_ : asks_; }
+  const std::vector<Level>& LevelsFor(Side side) const {
+    return side == Side::kBuy ? bids_ : asks_;
+  }
+  // Slot of a live order, or kNil for a stale or malformed id.
+  uint32_t Find(OrderId id) const;
+  // Fills against the opposite side of `side` at prices no worse than
+  // `limit_level`; returns the unfilled quantity.
+  double Match(Side side, int64_t limit_level, double quantity);
+  void Unlink(uint32_t slot);
+  void Release(uint32_t slot);
+
+  int64_t min_tick_;
+  size_t levels_;
+  std::vector<Level> bids_;
+  std::vector<Level> asks_;
+  std::vector<Node> nodes_;
+  uint32_t free_head_ = kNil;
+  size_t order_count_ = 0;
+  int64_t best_bid_ = -1;  // Level index.
+  int64_t best_ask_ = 0;   // Level index; levels_ when empty.
+};
+
+}  // namespace lvt
+
+#endif  // LARGE_VOLUME_TRADING_ORDER_BOOK_H_
@@ -0,0 +1,84 @@
+#include "market/synthetic_market_data.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include "market/timestamp.h"
+#include "util/philox.h"
+
+namespace lvt {
+
+namespace {
+
+constexpr double kSessionsPerYear = 252.0;
+constexpr uint32_t kPriceKind = 0;
+constexpr uint32_t kVolumeKind = 1;
+
+// 1970-01-01 was a Thursday; 0 = Sunday.
+int Weekday(int64_t epoch_day) { return static_cast<int>(((epoch_day + 4) % 7 + 7) % 7); }
+
+}  // namespace
+
+SyntheticMarketGenerator::SyntheticMarketGenerator(const SyntheticMarketConfig& config, uint32_t stream)
+    : config_(config), stream_(stream) {
+  config_.session_minutes = std::max(config_.session_minutes, 0);
+  const int m = config_.session_minutes;
+  volume_curve_.resize(m);
+  double total = 0.0;
+  for (int i = 0; i < m; ++i) {
+    const double x = 2.0 * (i + 0.5) / m - 1.0;
+    volume_curve_[i] = 1.0 + config_.u_shape * x * x;
+    total += volume_curve_[i];
+  }
+  // The log-normal noise has mean exp(-s^2/2 + s^2/2) = 1 with this shift.
+  const double noise_shift = -0.5 * config_.volume_noise * config_.volume_noise;
+  for (double& v : volume_curve_) v = std::log(v / total * config_.daily_volume) + noise_shift;
+}
+
+bool SyntheticMarketGenerator::Generate(const std::function<bool(MarketDataView)>& sink,
+                                        size_t batch_size) {
+  const int m = config_.session_minutes;
+  const double dt = 1.0 / (kSessionsPerYear * std::max(m, 1));
+  const double step_drift = (config_.drift - 0.5 * config_.volatility * config_.volatility) * dt;
+  const double step_vol = config_.volatility * std::sqrt(dt);
+  const Philox4x32::Key key = {static_cast<uint32_t>(config_.seed),
+                               static_cast<uint32_t>(config_.seed >> 32)};
+  batch_size = std::max<size_t>(batch_size, 1);
+  // Dividing by ticks-per-unit (rather than multiplying by the tick) gives
+  // the double nearest to the decimal price, which prints short.
+  const double ticks_per_unit = config_.tick_size > 0 ? 1.0 / config_.tick_size : 0.0;
+
+  MarketDataColumns batch;
+  batch.Reserve(batch_size);
+  double log_price = std::log(config_.initial_price);
+  int64_t day = config_.first_day;
+  std::array<double, 4> price_z{}, volume_z{};
+  for (size_t d = 0; d < config_.days; ++d, ++day) {
+    while (Weekday(day) == 0 || Weekday(day) == 6) ++day;
+    const int64_t open_ns = day * kNanosPerDay + config_.session_open_minute * kNanosPerMinute;
+    for (int i = 0; i < m; ++i) {
+      if (i % 4 == 0) {
+        const uint32_t block = static_cast<uint32_t>(i / 4);
+        price_z = NormalBlock(Philox4x32::Generate(
+            {block, kPriceKind, static_cast<uint32_t>(d), stream_}, key));
+        volume_z = NormalBlock(Philox4x32::Generate(
+            {block, kVolumeKind, static_cast<uint32_t>(d), stream_}, key));
+      }
+      log_price += step_drift + step_vol * price_z[i % 4];
+      double price = std::exp(log_price);
+      if (ticks_per_unit > 0) {
+        price = std::max(config_.tick_size, std::round(price * ticks_per_unit) / ticks_per_unit);
+      }
+      const double volume =
+          std::max(1.0, std::round(std::exp(volume_curve_[i] + config_.volume_noise * volume_z[i % 4])));
+      batch.Append(open_ns + i * kNanosPerMinute, price, volume);
+      if (batch.size() == batch_size) {
+        if (!sink(batch)) return false;
+        batch.Clear();
+      }
+    }
+  }
+  if (!batch.empty() && !sink(batch)) return false;
+  return true;
+}
+
+}  // namespace lvt
@@ -0,0 +1,60 @@
+#ifndef LARGE_VOLUME_TRADING_SYNTHETIC_MARKET_DATA_H_
+#define LARGE_VOLUME_TRADING_SYNTHETIC_MARKET_DATA_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "market/market_data_columns.h"
+
+namespace lvt {
+
+struct SyntheticMarketConfig {
+  uint64_t seed = 1;
+  size_t days = 1;               // Trading days; weekends are skipped.
+  int64_t first_day = 20094;     // Epoch day of the first session (2025-01-06).
+  int session_open_minute = 870;  // Minute of the UTC day (14:30).
+  int session_minutes = 390;
+  double initial_price = 100.0;
+  double drift = 0.0;       // Annualized GBM drift.
+  double volatility = 0.3;  // Annualized GBM volatility.
+  double tick_size = 0.01;  // Output prices are rounded to ticks; 0 = no rounding.
+  double daily_volume = 1e7;
+  // Intraday volume follows 1 + u_shape * (2x - 1)^2 over the session
+  // fraction x, so the open and close trade 1 + u_shape times the midday rate.
+  double u_shape = 3.0;
+  double volume_noise = 0.25;  // Log-normal sigma of per-bar volume.
+};
+
+// Minute bars for one symbol: a geometric Brownian motion price (252
+// sessions a year, no overnight move) and a U-shaped intraday volume curve
+// with log-normal noise, rounded to whole shares.
+//
+// Normals come from Philox blocks keyed by the seed with counter
+// (block, kind, day, stream), so a (seed, stream) pair always produces the
+// same bars and symbols can be generated on any thread in any order.
+class SyntheticMarketGenerator {
+ public:
+  static constexpr size_t kDefaultBatchSize = 64 * 1024;
+
+  SyntheticMarketGenerator(const SyntheticMarketConfig& config, uint32_t stream);
+
+  uint64_t row_count() const {
+    return static_cast<uint64_t>(config_.days) * static_cast<uint64_t>(config_.session_minutes);
+  }
+
+  // Generates every bar in time order and hands them to `sink` in batches
+  // of at most `batch_size` rows. Stops and returns false as soon as the
+  // sink returns false.
+  bool Generate(const std::function<bool(MarketDataView)>& sink,
+                size_t batch_size = kDefaultBatchSize);
+
+ private:
+  SyntheticMarketConfig config_;
+  uint32_t stream_;
+  std::vector<double> volume_curve_;  // Expected volume per session minute.
+};
+
+}  // namespace lvt
+
+#endif  // LARGE_VOLUME_TRADING_SYNTHETIC_MARKET_DATA_H_
@@ -0,0 +1,173 @@
+#include "market/timestamp.h"
+#include <limits>
+
+namespace lvt {
+
+namespace {
+
+// Days since 1970-01-01 for a proleptic Gregorian date (H. Hinnant's algorithm).
+int64_t DaysFromCivil(int64_t y, unsigned m, unsigned d) {
+  y -= m <= 2;
+  const int64_t era = (y >= 0 ? y : y - 399) / 400;
+  const unsigned yoe = static_cast<unsigned>(y - era * 400);
+  const unsigned doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;
+  const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+  return era * 146097 + static_cast<int64_t>(doe) - 719468;
+}
+
+void CivilFromDays(int64_t z, int64_t* year, unsigned* month, unsigned* day) {
+  z += 719468;
+  const int64_t era = (z >= 0 ? z : z - 146096) / 146097;
+  const unsigned doe = static_cast<unsigned>(z - era * 146097);
+  const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+  const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+  const unsigned mp = (5 * doy + 2) / 153;
+  *day = doy - (153 * mp + 2) / 5 + 1;
+  *month = mp < 10 ? mp + 3 : mp - 9;
+  *year = static_cast<int64_t>(yoe) + era * 400 + (*month <= 2);
+}
+
+int DaysInMonth(int year, int month) {
+  static constexpr int kDays[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+  const bool leap = year % 4 == 0 && (year % 100 != 0 || year % 400 == 0);
+  return month == 2 && leap ? 29 : kDays[month - 1];
+}
+
+bool IsDigit(char c) {
+  return c >= '0' && c <= '9';
+}
+
+// Reads exactly `count` digits at `*p`, advancing it.
+bool ReadDigits(const char*& p, const char* end, int count, int* value) {
+  if (end - p < count) return false;
+  int v = 0;
+  for (int i = 0; i < count; ++i) {
+    if (!IsDigit(p[i])) return false;
+    v = v * 10 + (p[i] - '0');
+  }
+  p += count;
+  *value = v;
+  return true;
+}
+
+char* WriteDigits(char* out, int64_t value, int count) {
+  for (int i = count - 1; i >= 0; --i) {
+    out[i] = static_cast<char>('0' + value % 10);
+    value /= 10;
+  }
+  return out + count;
+}
+
+}  // namespace
+
+bool ParseTimestamp(std::string_view text, int64_t* epoch_ns) {
+  const char* p = text.data();
+  const char* end = p + text.size();
+  while (p < end && (*p == ' ' || *p == '\t')) ++p;
+  while (end > p && (end[-1] == ' ' || end[-1] == '\t' || end[-1] == '\r')) --end;
+
+  int year, month, day;
+  if (!ReadDigits(p, end, 4, &year) || p == end || *p++ != '-' ||
+      !ReadDigits(p, end, 2, &month) || p == end || *p++ != '-' ||
+      !ReadDigits(p, end, 2, &day)) {
+    return false;
+  }
+  if (month < 1 || month > 12 || day < 1 || day > DaysInMonth(year, month)) return false;
+
+  int hour = 0, minute = 0, second = 0;
+  int64_t nanos = 0;
+  int64_t offset_seconds = 0;
+  if (p < end) {
+    if (*p != ' ' && *p != 'T') return false;
+    ++p;
+    if (!ReadDigits(p, end, 2, &hour) || p == end || *p++ != ':' ||
+        !ReadDigits(p, end, 2, &minute)) {
+      return false;
+    }
+    if (p < end && *p == ':') {
+      ++p;
+      if (!ReadDigits(p, end, 2, &second)) return false;
+      if (p < end && *p == '.') {
+        ++p;
+        int digits = 0;
+        while (p < end && IsDigit(*p)) {
+          if (digits < 9) {
+            nanos = nanos * 10 + (*p - '0');
+            ++digits;
+          }
+          ++p;
+        }
+        if (digits == 0) return false;
+        for (; digits < 9; ++digits) nanos *= 10;
+      }
+    }
+    if (p < end && *p == 'Z') {
+      ++p;
+    } else if (p < end && (*p == '+' || *p == '-')) {
+      const int sign = *p++ == '-' ? -1 : 1;
+      int offset_hours, offset_minutes = 0;
+      if (!ReadDigits(p, end, 2, &offset_hours)) return false;
+      // Minutes are optional, but a colon must be followed by them.
+      const bool colon = p < end && *p == ':';
+      if (colon) ++p;
+      if ((colon || p < end) && !ReadDigits(p, end, 2, &offset_minutes)) return false;
+      // No real UTC offset is more than 14 hours.
+      if (offset_minutes > 59 || offset_hours * 60 + offset_minutes > 14 * 60) return false;
+      offset_seconds = sign * (offset_hours * 3600 + offset_minutes * 60);
+    }
+    if (p != end) return false;
+    if (hour > 23 || minute > 59 || second > 60) return false;
+  }
+
+  const int64_t seconds = DaysFromCivil(year, month, day) * 86400 +
+                          hour * 3600 + minute * 60 + second - offset_seconds;
+  // int64 nanoseconds only reach years 1677..2262; later or earlier dates
+  // would overflow.
+  if (seconds < std::numeric_limits<int64_t>::min() / kNanosPerSecond ||
+      seconds > (std::numeric_limits<int64_t>::max() - nanos) / kNanosPerSecond) {
+    return false;
+  }
+  *epoch_ns = seconds * kNanosPerSecond + nanos;
+  return true;
+}
+
+size_t FormatTimestamp(int64_t epoch_ns, char* buffer) {
+  const int64_t days = EpochDay(epoch_ns);
+  const int64_t nanos_of_day = epoch_ns - days * kNanosPerDay;
+  const int64_t seconds_of_day = nanos_of_day / kNanosPerSecond;
+  int64_t fraction = nanos_of_day % kNanosPerSecond;
+  int64_t year;
+  unsigned month, day;
+  CivilFromDays(days, &year, &month, &day);
+
+  // int64 nanoseconds span years 1677..2262, so the year is always 4 digits.
+  char* out = WriteDigits(buffer, year, 4);
+  *out++ = '-';
+  out = WriteDigits(out, month, 2);
+  *out++ = '-';
+  out = WriteDigits(out, day, 2);
+  *out++ = ' ';
+  out = WriteDigits(out, seconds_of_day / 3600, 2);
+  *out++ = ':';
+  out = WriteDigits(out, seconds_of_day / 60 % 60, 2);
+  *out++ = ':';
+  out = WriteDigits(out, seconds_of_day % 60, 2);
+  if (fraction != 0) {
+    int digits = 9;
+    while (fraction % 10 == 0) {
+      fraction /= 10;
+      --digits;
+    }
+    *out++ = '.';
+    out = WriteDigits(out, fraction, digits);
+  }
+  for (char c : {'+', '0', '0', ':', '0', '0'}) *out++ = c;
+  return static_cast<size_t>(out - buffer);
+}
+
+std::string FormatTimestamp(int64_t epoch_ns) {
+  char buffer[kMaxTimestampLength];
+  return std::string(buffer, FormatTimestamp(epoch_ns, buffer));
+}
+
+}  // namespace lvt
@@ -0,0 +1,44 @@
+#ifndef LARGE_VOLUME_TRADING_TIMESTAMP_H_
+#define LARGE_VOLUME_TRADING_TIMESTAMP_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace lvt {
+
+constexpr int64_t kNanosPerSecond = 1000000000LL;
+constexpr int64_t kNanosPerMinute = 60 * kNanosPerSecond;
+constexpr int64_t kNanosPerDay = 86400 * kNanosPerSecond;
+
+// Longest text produced by FormatTimestamp().
+constexpr size_t kMaxTimestampLength = 36;
+
+// Parses ISO-8601 timestamps such as "2025-11-24 14:30:00+00:00" into
+// nanoseconds since the Unix epoch (UTC). Accepts ' ' or 'T' as the date/time
+// separator, optional seconds and fractional seconds, and an optional 'Z' or
+// +HH:MM / +HHMM / +HH offset. A bare date means midnight UTC.
+// Returns false if the text is not a valid timestamp.
+bool ParseTimestamp(std::string_view text, int64_t* epoch_ns);
+
+// Writes `epoch_ns` as "YYYY-MM-DD HH:MM:SS[.fffffffff]+00:00" into `buffer`
+// (at least kMaxTimestampLength bytes) and returns the number of characters.
+size_t FormatTimestamp(int64_t epoch_ns, char* buffer);
+std::string FormatTimestamp(int64_t epoch_ns);
+
+// UTC calendar day (days since 1970-01-01) of a timestamp.
+inline int64_t EpochDay(int64_t epoch_ns) {
+  int64_t day = epoch_ns / kNanosPerDay;
+  return (epoch_ns % kNanosPerDay < 0) ? day - 1 : day;
+}
+
+// Start of the UTC minute that contains `epoch_ns`.
+inline int64_t FloorToMinute(int64_t epoch_ns) {
+  int64_t rem = epoch_ns % kNanosPerMinute;
+  return rem < 0 ? epoch_ns - rem - kNanosPerMinute : epoch_ns - rem;
+}
+
+}  // namespace lvt
+
+#endif  // LARGE_VOLUME_TRADING_TIMESTAMP_H_
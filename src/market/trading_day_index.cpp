@@ -0,0 +1,34 @@
+#include "market/trading_day_index.h"
+#include <algorithm>
+#include "market/timestamp.h"
+
+namespace lvt {
+
+bool TradingDayIndex::Build(std::span<const int64_t> epoch_ns) {
+  Clear();
+  if (!std::is_sorted(epoch_ns.begin(), epoch_ns.end())) return false;
+  // Jump from one day boundary to the next with a binary search, so the
+  // cost is O(days * log n) rather than one division per bar.
+  auto it = epoch_ns.begin();
+  while (it != epoch_ns.end()) {
+    const int64_t day = EpochDay(*it);
+    days_.push_back(day);
+    offsets_.push_back(static_cast<size_t>(it - epoch_ns.begin()));
+    it = std::lower_bound(it, epoch_ns.end(), (day + 1) * kNanosPerDay);
+  }
+  offsets_.push_back(epoch_ns.size());
+  return true;
+}
+
+void TradingDayIndex::Clear() {
+  days_.clear();
+  offsets_.clear();
+}
+
+size_t TradingDayIndex::Find(int64_t epoch_day) const {
+  auto it = std::lower_bound(days_.begin(), days_.end(), epoch_day);
+  if (it == days_.end() || *it != epoch_day) return kNotFound;
+  return static_cast<size_t>(it - days_.begin());
+}
+
+}  // namespace lvt
@@ -0,0 +1,39 @@
+#ifndef LARGE_VOLUME_TRADING_TRADING_DAY_INDEX_H_
+#define LARGE_VOLUME_TRADING_TRADING_DAY_INDEX_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace lvt {
+
+// Offsets of every UTC calendar day in a time-sorted timestamp column, so
+// "bars of day D" is a binary search instead of a scan.
+class TradingDayIndex {
+ public:
+  static constexpr size_t kNotFound = static_cast<size_t>(-1);
+
+  // Indexes `epoch_ns`, which must be sorted ascending. Returns false (and
+  // leaves the index empty) if it is not.
+  bool Build(std::span<const int64_t> epoch_ns);
+  void Clear();
+
+  size_t day_count() const { return days_.size(); }
+  // Epoch day number (see EpochDay()) of the i-th indexed day.
+  int64_t day(size_t i) const { return days_[i]; }
+  // First bar of the i-th day and one past its last bar.
+  size_t begin(size_t i) const { return offsets_[i]; }
+  size_t end(size_t i) const { return offsets_[i + 1]; }
+
+  // Position of `epoch_day` among the indexed days, or kNotFound.
+  size_t Find(int64_t epoch_day) const;
+
+ private:
+  std::vector<int64_t> days_;
+  std::vector<size_t> offsets_;  // days_.size() + 1 entries
+};
+
+}  // namespace lvt
+
+#endif  // LARGE_VOLUME_TRADING_TRADING_DAY_INDEX_H_
@@ -0,0 +1,98 @@
+#include "market/volume_profile.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include "market/timestamp.h"
+#include "util/atomic_file_writer.h"
+#include "util/thread_pool.h"
+
+namespace lvt {
+
+namespace {
+
+size_t MinuteOfDay(int64_t epoch_ns) {
+  return static_cast<size_t>((epoch_ns - EpochDay(epoch_ns) * kNanosPerDay) / kNanosPerMinute);
+}
+
+}  // namespace
+
+VolumeProfile::VolumeProfile() : day_count_(0), first_day_(0), last_day_(0) {}
+
+bool VolumeProfile::Build(MarketDataView data, const TradingDayIndex& days, ThreadPool* pool) {
+  const size_t day_count = days.day_count();
+  if (day_count == 0) return false;
+  const auto epoch_ns = data.epoch_ns();
+  const auto volume = data.volume();
+
+  // Each task sums a contiguous range of days into its own bins; the
+  // partial sums are merged afterwards, so no bin is shared between threads.
+  const size_t tasks = pool != nullptr ? std::min(day_count, pool->size() + 1) : 1;
+  std::vector<std::vector<double>> partial(tasks, std::vector<double>(kMinutesPerDay, 0.0));
+  auto sum_days = [&](size_t t) {
+    std::vector<double>& bins = partial[t];
+    const size_t first = day_count * t / tasks;
+    const size_t last = day_count * (t + 1) / tasks;
+    for (size_t i = days.begin(first); i < days.end(last - 1); ++i) {
+      bins[MinuteOfDay(epoch_ns[i])] += volume[i];
+    }
+  };
+  if (pool != nullptr) {
+    pool->ParallelFor(tasks, sum_days);
+  } else {
+    sum_days(0);
+  }
+
+  std::vector<double> average(kMinutesPerDay, 0.0);
+  for (const auto& bins : partial) {
+    for (size_t m = 0; m < kMinutesPerDay; ++m) average[m] += bins[m];
+  }
+  for (double& v : average) v /= static_cast<double>(day_count);
+  average_volume_ = std::move(average);
+  day_count_ = day_count;
+  first_day_ = days.day(0);
+  last_day_ = days.day(day_count - 1);
+  return true;
+}
+
+double VolumeProfile::ExpectedVolume(int64_t epoch_ns) const {
+  return empty() ? 0.0 : average_volume_[MinuteOfDay(epoch_ns)];
+}
+
+bool VolumeProfile::Save(const std::string& path) const {
+  if (empty()) return false;
+  VolumeProfileHeader header = {};
+  std::memcpy(header.magic, kVolumeProfileMagic, sizeof(header.magic));
+  header.version = kVolumeProfileVersion;
+  header.bin_count = static_cast<uint32_t>(average_volume_.size());
+  header.day_count = day_count_;
+  header.first_day = first_day_;
+  header.last_day = last_day_;
+
+  AtomicFileWriter file;
+  if (!file.Open(path)) return false;
+  file.Write(&header, sizeof(header));
+  file.Write(average_volume_.data(), average_volume_.size() * sizeof(double));
+  return file.Commit();
+}
+
+bool VolumeProfile::Load(const std::string& path) {
+  std::ifstream file(path, std::ios::binary);
+  VolumeProfileHeader header;
+  if (!file.read(reinterpret_cast<char*>(&header), sizeof(header))) return false;
+  if (std::memcmp(header.magic, kVolumeProfileMagic, sizeof(header.magic)) != 0 ||
+      header.version != kVolumeProfileVersion || header.bin_count != kMinutesPerDay ||
+      header.day_count == 0) {
+    return false;
+  }
+  std::vector<double> average(header.bin_count);
+  if (!file.read(reinterpret_cast<char*>(average.data()), average.size() * sizeof(double))) {
+    return false;
+  }
+  average_volume_ = std::move(average);
+  day_count_ = header.day_count;
+  first_day_ = header.first_day;
+  last_day_ = header.last_day;
+  return true;
+}
+
+}  // namespace lvt
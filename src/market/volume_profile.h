@@ -0,0 +1,75 @@
+#ifndef LARGE_VOLUME_TRADING_VOLUME_PROFILE_H_
+#define LARGE_VOLUME_TRADING_VOLUME_PROFILE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+#include "market/market_data_columns.h"
+#include "market/trading_day_index.h"
+
+namespace lvt {
+
+class ThreadPool;
+
+// Average intraday volume curve: mean volume per UTC minute of day over a
+// set of historical trading days. A forward-looking VWAP can weight a future
+// session by this curve instead of by the bars it is trading.
+//
+// Saved profiles use a small binary layout (native little-endian):
+//   VolumeProfileHeader   48 bytes
+//   double average_volume[bin_count]
+class VolumeProfile {
+ public:
+  static constexpr size_t kMinutesPerDay = 1440;
+
+  VolumeProfile();
+
+  // Builds the curve from time-sorted bars and their day index in a single
+  // pass; days are split across `pool` when one is given. Every day counts
+  // in the average, also for minutes in which it had no bar. Returns false
+  // if there are no days.
+  bool Build(MarketDataView data, const TradingDayIndex& days, ThreadPool* pool = nullptr);
+
+  bool empty() const { return day_count_ == 0; }
+  size_t day_count() const { return day_count_; }
+  // First and last epoch day (see EpochDay()) the profile was built from.
+  int64_t first_day() const { return first_day_; }
+  int64_t last_day() const { return last_day_; }
+
+  // kMinutesPerDay bins, indexed by minute of day (UTC).
+  std::span<const double> average_volume() const { return average_volume_; }
+  // Average volume of the minute that contains `epoch_ns`.
+  double ExpectedVolume(int64_t epoch_ns) const;
+
+  // Writes the profile under a temporary name and renames it into place.
+  bool Save(const std::string& path) const;
+  // Replaces this profile with one from disk. Returns false (and leaves the
+  // profile unchanged) if the file is missing or malformed.
+  bool Load(const std::string& path);
+
+ private:
+  std::vector<double> average_volume_;
+  size_t day_count_;
+  int64_t first_day_;
+  int64_t last_day_;
+};
+
+constexpr char kVolumeProfileMagic[8] = {'L', 'V', 'T', 'V', 'P', 'R', '0', '1'};
+constexpr uint32_t kVolumeProfileVersion = 1;
+
+struct VolumeProfileHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t bin_count;
+  uint64_t day_count;
+  int64_t first_day;
+  int64_t last_day;
+  uint64_t reserved;
+};
+static_assert(sizeof(VolumeProfileHeader) == 48, "header layout must stay fixed");
+
+}  // namespace lvt
+
+#endif  // LARGE_VOLUME_TRADING_VOLUME_PROFILE_H_
@@ -0,0 +1,59 @@
+#include "order/fill_simulator.h"
+#include <algorithm>
+#include <limits>
+
+namespace lvt {
+
+FillSimulator::FillSimulator(const FillModel& model) : model_(model), filled_so_far_(0) {}
+
+void FillSimulator::Simulate(MarketDataView bars, std::span<const double> schedule,
+                             std::span<double> fills, std::span<double> fill_prices) const {
+  const size_t n = std::min({bars.size(), schedule.size(), fills.size(), fill_prices.size()});
+  const double* order = schedule.data();
+  const double* price = bars.price().data();
+  const double* volume = bars.volume().data();
+  double* fill = fills.data();
+  double* out_price = fill_prices.data();
+  // A zero cap means unlimited; infinity keeps the cap pass branch-free
+  // (inf * 0 volume is NaN, which std::min ignores in the second position).
+  const double cap = model_.max_participation > 0 ? model_.max_participation
+                                                  : std::numeric_limits<double>::infinity();
+  for (size_t i = 0; i < n; ++i) fill[i] = std::max(0.0, std::min(order[i], cap * volume[i]));
+  // Exclusive running total of fills, parked in the price array.
+  double total = 0.0;
+  for (size_t i = 0; i < n; ++i) {
+    out_price[i] = total;
+    total += fill[i];
+  }
+  const double sign = model_.sell ? -1.0 : 1.0;
+  const double gamma = sign * model_.gamma;
+  const double eta = sign * model_.eta;
+  for (size_t i = 0; i < n; ++i) out_price[i] = price[i] + gamma * out_price[i] + eta * fill[i];
+}
+
+FillSummary FillSimulator::Summarize(MarketDataView bars, std::span<const double> fills,
+                                    std::span<const double> fill_prices) const {
+  const size_t n = std::min({bars.size(), fills.size(), fill_prices.size()});
+  const double* price = bars.price().data();
+  double filled = 0.0;
+  double impact = 0.0;
+  for (size_t i = 0; i < n; ++i) {
+    filled += fills[i];
+    impact += fills[i] * (fill_prices[i] - price[i]);
+  }
+  FillSummary summary;
+  summary.filled_volume = filled;
+  summary.impact_cost = model_.sell ? -impact : impact;
+  return summary;
+}
+
+double FillSimulator::Fill(const MarketData& bar, double quantity, double* fill_price) {
+  double fill = std::max(0.0, quantity);
+  if (model_.max_participation > 0) fill = std::min(fill, model_.max_participation * bar.volume);
+  const double sign = model_.sell ? -1.0 : 1.0;
+  *fill_price = bar.price + sign * (model_.gamma * filled_so_far_ + model_.eta * fill);
+  filled_so_far_ += fill;
+  return fill;
+}
+
+}  // namespace lvt
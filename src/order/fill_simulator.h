@@ -0,0 +1,61 @@
+#ifndef LARGE_VOLUME_TRADING_FILL_SIMULATOR_H_
+#define LARGE_VOLUME_TRADING_FILL_SIMULATOR_H_
+
+#include <span>
+#include "market/market_data.h"
+#include "market/market_data_columns.h"
+
+namespace lvt {
+
+// Linear market impact with a participation cap, in the Almgren-Chriss
+// form used by AlmgrenKrissModel (unit-length intervals):
+//   fill_k  = min(order_k, max_participation * bar_volume_k)
+//   price_k = bar_price_k + side * (gamma * (fill_0 + ... + fill_{k-1}) + eta * fill_k)
+// where side is +1 for buys and -1 for sells. The unfilled part of an order
+// is not carried over; the strategy sees the short fill and re-plans.
+struct FillModel {
+  double eta = 0.0;                // Temporary impact per unit traded in a bar.
+  double gamma = 0.0;              // Permanent impact per unit traded before.
+  double max_participation = 0.0;  // Cap as a fraction of bar volume; 0 = none.
+  bool sell = false;
+};
+
+// Totals of a whole-schedule simulation.
+struct FillSummary {
+  double filled_volume = 0.0;
+  // side * sum fill_i * (fill_price_i - bar_price_i): what impact added to
+  // the cost of the fills, as in BacktestReport::impact_cost.
+  double impact_cost = 0.0;
+};
+
+class FillSimulator {
+ public:
+  explicit FillSimulator(const FillModel& model = FillModel());
+
+  const FillModel& model() const { return model_; }
+
+  // Whole-schedule form, used by ParameterSweep and BatchRunner: order i
+  // goes to bar i. Writes fills and fill prices for min(bars, schedule,
+  // fills, fill_prices) entries. The cap and price passes run over plain
+  // arrays and are vectorized by the compiler; only the running total of
+  // fills is a serial pass. Independent of the per-bar state below.
+  void Simulate(MarketDataView bars, std::span<const double> schedule, std::span<double> fills,
+                std::span<double> fill_prices) const;
+  // Totals of a Simulate() result over the same bars.
+  FillSummary Summarize(MarketDataView bars, std::span<const double> fills,
+                        std::span<const double> fill_prices) const;
+
+  // Per-bar form for event loops; keeps the running total for permanent impact.
+  // Returns the filled quantity and stores its price in `fill_price`.
+  double Fill(const MarketData& bar, double quantity, double* fill_price);
+  // Forgets the running total.
+  void Reset() { filled_so_far_ = 0.0; }
+
+ private:
+  FillModel model_;
+  double filled_so_far_;
+};
+
+}  // namespace lvt
+
+#endif  // LARGE_VOLUME_TRADING_FILL_SIMULATOR_H_
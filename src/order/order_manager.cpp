@@ -1,20 +1,59 @@
 #include "order/order_manager.h"
+#include <iostream>
+#include <thread>
+#include "util/instrumentation.h"
 
 namespace lvt {
 
-OrderManager::OrderManager() : next_order_id_(1) {}
+OrderManager::OrderManager(std::pmr::memory_resource* resource)
+    : next_order_id_(1), records_(resource) {}
 
-void OrderManager::IssueOrder(double quantity, double price, const std::string& timestamp) {
+OrderManager::OrderManager(size_t submission_capacity, std::pmr::memory_resource* resource)
+    : next_order_id_(1),
+      records_(resource),
+      submissions_(std::make_unique<MpscRingBuffer<ExecutionRecord>>(submission_capacity)) {}
+
+void OrderManager::Reserve(size_t capacity) {
+  records_.reserve(capacity);
+}
+
+int64_t OrderManager::IssueOrder(double quantity, double price, int64_t epoch_ns) {
+  LVT_STAGE_TIMER(Stage::kIssueOrder);
+  const int64_t order_id = next_order_id_.fetch_add(1, std::memory_order_relaxed);
+  records_.push_back({order_id, quantity, price, epoch_ns});
+  return order_id;
+}
+
+int64_t OrderManager::SubmitOrder(double quantity, double price, int64_t epoch_ns) {
+  LVT_STAGE_TIMER(Stage::kSubmitOrder);
+  if (submissions_ == nullptr) {
+    std::cerr << "[Error] SubmitOrder needs an OrderManager with a submission capacity" << std::endl;
+    return -1;
+  }
+  const ExecutionRecord record = {next_order_id_.fetch_add(1, std::memory_order_relaxed), quantity,
+                                  price, epoch_ns};
+  while (!submissions_->TryPush(record)) std::this_thread::yield();
+  return record.order_id;
+}
+
+size_t OrderManager::DrainSubmissions(size_t max_orders) {
+  LVT_STAGE_TIMER(Stage::kDrainSubmissions);
+  if (submissions_ == nullptr) return 0;
+  size_t drained = 0;
   ExecutionRecord record;
-  record.order_id = next_order_id_++;
-  record.quantity = quantity;
-  record.price = price;
-  record.timestamp = timestamp;
-  records_.push_back(record);
+  while (drained < max_orders && submissions_->TryPop(&record)) {
+    records_.push_back(record);
+    ++drained;
+  }
+  return drained;
 }
 
-const std::vector<ExecutionRecord>& OrderManager::GetExecutions() const {
+std::span<const ExecutionRecord> OrderManager::GetExecutions() const {
   return records_;
 }
 
+void OrderManager::Clear() {
+  records_.clear();
+}
+
 }  // namespace lvt
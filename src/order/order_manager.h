@@ -1,28 +1,67 @@
 #ifndef LARGE_VOLUME_TRADING_ORDER_MANAGER_H_
 #define LARGE_VOLUME_TRADING_ORDER_MANAGER_H_
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <span>
 #include <vector>
-#include <string>
+#include "util/mpsc_ring_buffer.h"
 
 namespace lvt {
 
-// Struct to record order executions.
+// Struct to record order executions. Fixed size and trivially copyable;
+// timestamps are nanoseconds since the Unix epoch (see market/timestamp.h).
 struct ExecutionRecord {
-  int order_id;
+  int64_t order_id;
   double quantity;
   double price;
-  std::string timestamp;
+  int64_t epoch_ns;
 };
 
 class OrderManager {
  public:
-  OrderManager();
-  void IssueOrder(double quantity, double price, const std::string& timestamp);
-  const std::vector<ExecutionRecord>& GetExecutions() const;
+  // Records are stored through `resource`, e.g. a monotonic_buffer_resource
+  // to keep them in an arena. The resource must outlive the manager.
+  explicit OrderManager(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+  // Also sets up a submission queue of `submission_capacity` slots (rounded
+  // up to a power of two) for SubmitOrder().
+  OrderManager(size_t submission_capacity,
+               std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+  // Preallocates room for `capacity` records. IssueOrder() does not
+  // allocate while size() < capacity().
+  void Reserve(size_t capacity);
+
+  // Records one child order and returns its id (ids start at 1).
+  // Call from the thread that owns the execution log.
+  int64_t IssueOrder(double quantity, double price, int64_t epoch_ns);
+
+  // Concurrent path, callable from any number of threads: takes an id
+  // atomically and pushes the order into a lock-free ring without locks or
+  // allocation. If the ring is full the caller yields until the consumer
+  // frees a slot. Needs a manager constructed with a submission capacity;
+  // returns -1 without taking an id otherwise.
+  int64_t SubmitOrder(double quantity, double price, int64_t epoch_ns);
+
+  // Consumer side: moves up to `max_orders` queued submissions into the
+  // execution log and returns how many were moved. One thread at a time,
+  // the same one that calls IssueOrder() and reads the executions.
+  size_t DrainSubmissions(size_t max_orders = SIZE_MAX);
+
+  std::span<const ExecutionRecord> GetExecutions() const;
+  size_t size() const { return records_.size(); }
+  size_t capacity() const { return records_.capacity(); }
+
+  // Drops the records but keeps their storage for the next run; ids keep counting.
+  void Clear();
 
  private:
-  int next_order_id_;
-  std::vector<ExecutionRecord> records_;
+  std::atomic<int64_t> next_order_id_;
+  std::pmr::vector<ExecutionRecord> records_;
+  std::unique_ptr<MpscRingBuffer<ExecutionRecord>> submissions_;
 };
 
 }  // namespace lvt
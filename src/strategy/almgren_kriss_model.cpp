@@ -1,15 +1,29 @@
 #include "strategy/almgren_kriss_model.h"
 #include <cmath>
 #include <algorithm>
+#include <numeric>
+#include "util/instrumentation.h"
+#include "util/thread_pool.h"
+#include "util/vector_math.h"
 
 namespace lvt {
 
+namespace {
+
+// log(sinh(y)) for y > 0, accurate for both tiny and very large y.
+double LogSinh(double y) {
+  return y + std::log(-std::expm1(-2.0 * y)) - std::log(2.0);
+}
+
+}  // namespace
+
 AlmgrenKrissModel::AlmgrenKrissModel()
     : eta_(0), gamma_(0), sigma_(0), lambda_(0), total_volume_(0) {}
 
-void AlmgrenKrissModel::SetMarketData(const std::vector<double>& prices, double total_volume) {
+void AlmgrenKrissModel::SetMarketData(std::span<const double> prices, double total_volume) {
   prices_ = prices;
   total_volume_ = total_volume;
+  sessions_.clear();
 }
 
 void AlmgrenKrissModel::SetParameters(double eta, double gamma, double sigma, double lam) {
@@ -21,57 +35,119 @@ void AlmgrenKrissModel::SetParameters(double eta, double gamma, double sigma, do
 
 void AlmgrenKrissModel::ComputeOptimalSchedule() {
   schedule_.clear();
+  session_offsets_.clear();
   const int N = static_cast<int>(prices_.size());
   if (N == 0 || total_volume_ <= 0) return;
+  schedule_.resize(N);
+  SolveSession(total_volume_, schedule_);
+}
+
+void AlmgrenKrissModel::SolveSession(double volume, std::span<double> out) const {
+  LVT_STAGE_TIMER(Stage::kAlmgrenKriss);
+  const size_t N = out.size();
+  if (N == 0) return;
   if (N == 1) {
-    schedule_.push_back(total_volume_);
+    out[0] = volume;
     return;
   }
-  double uniform_chunk = total_volume_ / N;
+  auto fill_uniform = [&] { std::fill(out.begin(), out.end(), volume / N); };
   if (eta_ <= 1e-10 || lambda_ <= 1e-10 || sigma_ <= 1e-10) {
-    schedule_ = std::vector<double>(N, uniform_chunk);
+    fill_uniform();
     return;
   }
   double kappa = std::sqrt(lambda_ * sigma_ * sigma_ / eta_);
   if (!std::isfinite(kappa) || kappa <= 0) {
-    schedule_ = std::vector<double>(N, uniform_chunk);
+    fill_uniform();
     return;
   }
-  const double MAX_KAPPA_DISTANCE = 700.0;
-  double center = 0.5 * (N - 1);
-  double max_distance = std::max(center, static_cast<double>(N - 1) - center);
-  if (kappa * max_distance > MAX_KAPPA_DISTANCE) {
-    schedule_ = std::vector<double>(N, uniform_chunk);
+  // Trade sizes are proportional to cosh(kappa * (i - c)), c = (N - 1) / 2,
+  // whose sum has the closed form sinh(N * kappa / 2) / sinh(kappa / 2).
+  // Working with log(norm) and splitting cosh into two exponentials keeps
+  // every intermediate bounded by 1, so no kappa overflows.
+  const double center = 0.5 * static_cast<double>(N - 1);
+  const double log_norm = LogSinh(0.5 * kappa * static_cast<double>(N)) - LogSinh(0.5 * kappa);
+  if (!std::isfinite(log_norm)) {
+    fill_uniform();
     return;
   }
-  double norm = 0.0;
-  for (int i = 0; i < N; ++i) {
-    double distance = i - center;
-    double arg = kappa * distance;
-    double weight = std::cosh(arg);
-    if (!std::isfinite(weight) || weight > 1e300) {
-      schedule_ = std::vector<double>(N, uniform_chunk);
-      return;
-    }
-    schedule_.push_back(weight);
-    norm += weight;
-    if (!std::isfinite(norm)) {
-      schedule_ = std::vector<double>(N, uniform_chunk);
-      return;
+  // The profile is symmetric: evaluate the first half and mirror it.
+  const size_t half = (N + 1) / 2;
+  // Blocks keep the inner index an int, whose conversion to double vectorizes.
+  constexpr size_t kBlock = 4096;
+  double* dst = out.data();
+  const double scale = 0.5 * volume;
+  for (size_t block = 0; block < half; block += kBlock) {
+    const int len = static_cast<int>(std::min(kBlock, half - block));
+    const double base = static_cast<double>(block) - center;
+    double* block_out = dst + block;
+    for (int j = 0; j < len; ++j) {
+      const double arg = kappa * (base + j);
+      block_out[j] = scale * (FastExp(arg - log_norm) + FastExp(-arg - log_norm));
     }
   }
-  if (norm <= 0 || !std::isfinite(norm)) {
-    schedule_ = std::vector<double>(N, uniform_chunk);
+  for (size_t i = half; i < N; ++i) dst[i] = dst[N - 1 - i];
+}
+
+const std::vector<double>& AlmgrenKrissModel::GetSchedule() const {
+  return schedule_;
+}
+
+void AlmgrenKrissModel::SetSessions(std::vector<std::span<const double>> sessions,
+                                    double total_volume) {
+  sessions_ = std::move(sessions);
+  prices_ = {};
+  total_volume_ = total_volume;
+}
+
+void AlmgrenKrissModel::ComputeMultiDaySchedule(ThreadPool* pool) {
+  schedule_.clear();
+  session_offsets_.clear();
+  size_t total_intervals = 0;
+  for (const auto& session : sessions_) {
+    session_offsets_.push_back(total_intervals);
+    total_intervals += session.size();
+  }
+  if (total_intervals == 0 || total_volume_ <= 0) {
+    session_offsets_.clear();
     return;
   }
-  for (auto& x : schedule_) {
-    x = total_volume_ * x / norm;
-    if (!std::isfinite(x)) x = uniform_chunk;  // Safety fallback
+  schedule_.resize(total_intervals);
+  // Sessions only share their budget, which is fixed up front, so each one
+  // can be solved on its own.
+  auto solve = [&](size_t d) {
+    const size_t n = sessions_[d].size();
+    const double budget = total_volume_ * static_cast<double>(n) / total_intervals;
+    SolveSession(budget, std::span<double>(schedule_).subspan(session_offsets_[d], n));
+  };
+  if (pool != nullptr) {
+    pool->ParallelFor(sessions_.size(), solve);
+  } else {
+    for (size_t d = 0; d < sessions_.size(); ++d) solve(d);
   }
 }
 
-const std::vector<double>& AlmgrenKrissModel::GetSchedule() const {
-  return schedule_;
+const std::vector<size_t>& AlmgrenKrissModel::GetSessionOffsets() const {
+  return session_offsets_;
+}
+
+double AlmgrenKrissModel::ExpectedCost() const {
+  double total = 0.0;
+  double sum_sq = 0.0;
+  for (double n : schedule_) {
+    total += n;
+    sum_sq += n * n;
+  }
+  return 0.5 * gamma_ * total * total + (eta_ - 0.5 * gamma_) * sum_sq;
+}
+
+double AlmgrenKrissModel::CostVariance() const {
+  double remaining = std::accumulate(schedule_.begin(), schedule_.end(), 0.0);
+  double sum_sq = 0.0;
+  for (double n : schedule_) {
+    remaining -= n;
+    sum_sq += remaining * remaining;
+  }
+  return sigma_ * sigma_ * sum_sq;
 }
 
 }  // namespace lvt
@@ -1,25 +1,60 @@
 #ifndef LARGE_VOLUME_TRADING_ALMGREN_KRISS_MODEL_H_
 #define LARGE_VOLUME_TRADING_ALMGREN_KRISS_MODEL_H_
 
+#include <cstddef>
+#include <span>
 #include <vector>
 
 namespace lvt {
 
+class ThreadPool;
+
+// One Almgren-Kriss parameter set; defaults match the CLI defaults.
+struct AlmgrenKrissParams {
+  double eta = 1.0;
+  double gamma = 0.01;
+  double sigma = 0.5;
+  double lambda = 1.0;
+};
+
 class AlmgrenKrissModel {
  public:
   AlmgrenKrissModel();
-  void SetMarketData(const std::vector<double>& prices, double total_volume);
+  // Keeps a non-owning view of `prices`; they must outlive the model's use of them.
+  void SetMarketData(std::span<const double> prices, double total_volume);
   void SetParameters(double eta, double gamma, double sigma, double lam);
   void ComputeOptimalSchedule();
   const std::vector<double>& GetSchedule() const;
 
+  // Multi-session execution: one price slice per trading day (views, as for
+  // SetMarketData). Replaces any single-session data.
+  void SetSessions(std::vector<std::span<const double>> sessions, double total_volume);
+
+  // Splits the parent order across sessions in proportion to their number of
+  // intervals, then solves every session's trajectory independently, in
+  // parallel on `pool` when one is given. GetSchedule() holds the sessions'
+  // schedules back to back; GetSessionOffsets() tells where each one starts.
+  void ComputeMultiDaySchedule(ThreadPool* pool = nullptr);
+  const std::vector<size_t>& GetSessionOffsets() const;
+
+  // Almgren-Chriss cost of the current schedule with unit-length intervals:
+  // E = gamma X^2 / 2 + (eta - gamma / 2) sum n_k^2 and V = sigma^2 sum x_k^2,
+  // where n_k are the trades and x_k the volume still held after trade k.
+  double ExpectedCost() const;
+  double CostVariance() const;
+
  private:
+  // Writes the single-session trajectory of `volume` over out.size() intervals.
+  void SolveSession(double volume, std::span<double> out) const;
+
   double eta_;
   double gamma_;
   double sigma_;
   double lambda_;
   double total_volume_;
-  std::vector<double> prices_;
+  std::span<const double> prices_;
+  std::vector<std::span<const double>> sessions_;
+  std::vector<size_t> session_offsets_;
   std::vector<double> schedule_;
 };
 
@@ -0,0 +1,67 @@
+#include "strategy/incremental_vwap.h"
+#include <algorithm>
+
+namespace lvt {
+
+IncrementalVWAP::IncrementalVWAP()
+    : total_volume_(0),
+      remaining_(0),
+      next_slice_(0),
+      bars_seen_(0),
+      market_volume_(0),
+      market_notional_(0),
+      executed_notional_(0) {}
+
+void IncrementalVWAP::Start(std::span<const double> expected_volume, double total_volume) {
+  expected_.assign(expected_volume.begin(), expected_volume.end());
+  expected_suffix_.assign(expected_.size() + 1, 0.0);
+  for (size_t k = expected_.size(); k-- > 0;) {
+    expected_suffix_[k] = expected_suffix_[k + 1] + std::max(expected_[k], 0.0);
+  }
+  total_volume_ = std::max(total_volume, 0.0);
+  remaining_ = total_volume_;
+  bars_seen_ = 0;
+  market_volume_ = 0;
+  market_notional_ = 0;
+  executed_notional_ = 0;
+  UpdateNextSlice();
+}
+
+double IncrementalVWAP::OnBar(const MarketData& bar) {
+  return OnBar(bar, next_slice_);
+}
+
+double IncrementalVWAP::OnBar(const MarketData& bar, double executed_volume) {
+  const double filled = std::clamp(executed_volume, 0.0, remaining_);
+  remaining_ -= filled;
+  executed_notional_ += filled * bar.price;
+  market_volume_ += bar.volume;
+  market_notional_ += bar.volume * bar.price;
+  ++bars_seen_;
+  UpdateNextSlice();
+  return next_slice_;
+}
+
+void IncrementalVWAP::UpdateNextSlice() {
+  const size_t n = expected_.size();
+  const size_t k = bars_seen_;
+  if (k >= n || remaining_ <= 0) {
+    next_slice_ = remaining_;
+  } else if (expected_suffix_[k] > 0) {
+    next_slice_ = remaining_ * (std::max(expected_[k], 0.0) / expected_suffix_[k]);
+  } else {
+    // No volume expected for the rest of the session: spread evenly.
+    next_slice_ = remaining_ / static_cast<double>(n - k);
+  }
+}
+
+double IncrementalVWAP::MarketVWAP() const {
+  return market_volume_ > 0 ? market_notional_ / market_volume_ : 0.0;
+}
+
+double IncrementalVWAP::ExecutionVWAP() const {
+  const double executed = executed_volume();
+  return executed > 0 ? executed_notional_ / executed : 0.0;
+}
+
+}  // namespace lvt
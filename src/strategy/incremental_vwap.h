@@ -0,0 +1,61 @@
+#ifndef LARGE_VOLUME_TRADING_INCREMENTAL_VWAP_H_
+#define LARGE_VOLUME_TRADING_INCREMENTAL_VWAP_H_
+
+#include <cstddef>
+#include <span>
+#include <vector>
+#include "market/market_data.h"
+
+namespace lvt {
+
+// Online VWAP for live trading: keeps the allocation of the remaining
+// quantity current as bars arrive, without re-running the batch schedule.
+//
+// The session's expected volume per interval (e.g. a historical profile) is
+// turned into suffix sums once in Start(); after that every OnBar() is O(1):
+//   next slice = remaining * expected[k] / (expected[k] + ... + expected[n-1]).
+// When the expected profile equals the realized volumes and every slice is
+// filled, the slices are exactly VWAPCalculator's batch schedule.
+class IncrementalVWAP {
+ public:
+  IncrementalVWAP();
+
+  // Begins a session of expected_volume.size() intervals. O(n); resets state.
+  void Start(std::span<const double> expected_volume, double total_volume);
+
+  // Closes the current interval with `bar` and returns the next slice.
+  // The planned slice is assumed filled; the second form takes the actual fill.
+  double OnBar(const MarketData& bar);
+  double OnBar(const MarketData& bar, double executed_volume);
+
+  // Quantity to trade in the current interval. After the last planned
+  // interval this is whatever is left, to be completed at once.
+  double NextSlice() const { return next_slice_; }
+
+  double remaining_volume() const { return remaining_; }
+  double executed_volume() const { return total_volume_ - remaining_; }
+  size_t bars_seen() const { return bars_seen_; }
+
+  // Volume-weighted price of the bars seen so far; 0 before the first bar.
+  double MarketVWAP() const;
+  // Volume-weighted price of our fills, taken at bar prices; 0 before any fill.
+  double ExecutionVWAP() const;
+
+ private:
+  void UpdateNextSlice();
+
+  std::vector<double> expected_;
+  // expected_suffix_[k] = expected_[k] + ... + expected_[n-1]; one extra 0.
+  std::vector<double> expected_suffix_;
+  double total_volume_;
+  double remaining_;
+  double next_slice_;
+  size_t bars_seen_;
+  double market_volume_;
+  double market_notional_;
+  double executed_notional_;
+};
+
+}  // namespace lvt
+
+#endif  // LARGE_VOLUME_TRADING_INCREMENTAL_VWAP_H_
@@ -1,24 +1,68 @@
 #include "strategy/limit_order_speed_model.h"
 #include <algorithm>
+#include <limits>
+#include "util/instrumentation.h"
 
 namespace lvt {
 
+double AllocateWithinCapacity(double total, std::span<const double> capacity,
+                              std::span<double> allocation) {
+  const size_t n = std::min(capacity.size(), allocation.size());
+  if (n == 0) return std::max(total, 0.0);
+  if (!(total > 0)) {
+    std::fill(allocation.begin(), allocation.begin() + n, 0.0);
+    return 0.0;
+  }
+  // Walk the capacities from the smallest up: each one that is below an
+  // even share of what is left is filled completely and drops out.
+  std::vector<double> sorted(capacity.begin(), capacity.begin() + n);
+  std::sort(sorted.begin(), sorted.end());
+  double remaining = total;
+  double level = std::numeric_limits<double>::infinity();
+  for (size_t j = 0; j < n; ++j) {
+    const double cap = std::max(sorted[j], 0.0);
+    if (cap * static_cast<double>(n - j) >= remaining) {
+      level = remaining / static_cast<double>(n - j);
+      remaining = 0.0;
+      break;
+    }
+    remaining -= cap;
+  }
+  for (size_t i = 0; i < n; ++i) allocation[i] = std::max(0.0, std::min(capacity[i], level));
+  return remaining;
+}
+
 LimitOrderSpeedModel::LimitOrderSpeedModel() = default;
 
-void LimitOrderSpeedModel::SetMarketData(const std::vector<MarketData>& market_data) {
+void LimitOrderSpeedModel::SetMarketData(MarketDataView market_data) {
   market_data_ = market_data;
 }
 
-void LimitOrderSpeedModel::ComputeOptimalSpeedSchedule(double total_volume, int intervals, double max_speed) {
+void LimitOrderSpeedModel::ComputeOptimalSpeedSchedule(double total_volume, int intervals, double max_speed,
+                                                       double max_participation) {
+  LVT_STAGE_TIMER(Stage::kOptimalSpeed);
   schedule_.clear();
+  unfilled_volume_ = 0.0;
   if (total_volume <= 0) return;
   int n = intervals > 0 ? intervals : (int)market_data_.size();
   if (n <= 0) return;
-  double chunk = total_volume / n;
-  if (max_speed > 0.0) chunk = std::min(chunk, max_speed);
-  schedule_ = std::vector<double>(n, chunk);
-  double remainder = total_volume - chunk * n;
-  if (remainder > 0 && !schedule_.empty()) schedule_.back() += remainder;
+
+  const double speed_cap = max_speed > 0.0 ? max_speed : std::numeric_limits<double>::infinity();
+  capacity_.assign(n, speed_cap);
+  if (max_participation > 0.0 && !market_data_.empty()) {
+    // Bar b belongs to interval b * n / bars, so intervals cover equal
+    // shares of the bars.
+    std::vector<double> interval_volume(n, 0.0);
+    const auto volume = market_data_.volume();
+    for (size_t b = 0; b < volume.size(); ++b) {
+      interval_volume[b * static_cast<size_t>(n) / volume.size()] += volume[b];
+    }
+    for (int i = 0; i < n; ++i) {
+      capacity_[i] = std::min(speed_cap, max_participation * interval_volume[i]);
+    }
+  }
+  schedule_.resize(n);
+  unfilled_volume_ = AllocateWithinCapacity(total_volume, capacity_, schedule_);
 }
 
 const std::vector<double>& LimitOrderSpeedModel::GetSchedule() const {
@@ -1,27 +1,47 @@
 #ifndef LARGE_VOLUME_TRADING_LIMIT_ORDER_SPEED_MODEL_H_
 #define LARGE_VOLUME_TRADING_LIMIT_ORDER_SPEED_MODEL_H_
 
+#include <span>
 #include <vector>
-#include "market/market_simulator.h"
+#include "market/market_data_columns.h"
 
 namespace lvt {
 
+// Spreads `total` over slots with the given capacities (infinity = no limit)
+// as evenly as they allow: every slot gets min(capacity, level) for the one
+// water level that uses up `total`, which minimizes the sum of squared slice
+// sizes (linear temporary impact). Runs in O(n log n). Writes the slices to
+// `allocation` (same size as `capacity`) and returns the volume that does
+// not fit.
+double AllocateWithinCapacity(double total, std::span<const double> capacity,
+                              std::span<double> allocation);
+
 class LimitOrderSpeedModel {
  public:
   LimitOrderSpeedModel();
 
   // Sets the market data context (timestamp, price, volume for each interval).
-  void SetMarketData(const std::vector<MarketData>& market_data);
+  // Only a view is kept; the data must outlive the model's use of it.
+  void SetMarketData(MarketDataView market_data);
 
-  // Computes the speed (order size) for each interval, subject to max_speed (0 = unlimited).
-  void ComputeOptimalSpeedSchedule(double total_volume, int intervals, double max_speed = 0.);
+  // Computes the speed (order size) for each interval. Each interval may
+  // trade at most max_speed and at most max_participation times the market
+  // volume of its bars (0 = unlimited; the participation cap needs market
+  // data). Volume capped off one interval is spread over the intervals with
+  // spare capacity; what fits nowhere is left in GetUnfilledVolume().
+  void ComputeOptimalSpeedSchedule(double total_volume, int intervals, double max_speed = 0.,
+                                   double max_participation = 0.);
 
   // Returns per-interval order sizes.
   const std::vector<double>& GetSchedule() const;
+  // Volume of the last computation that exceeded the total capacity.
+  double GetUnfilledVolume() const { return unfilled_volume_; }
 
  private:
-  std::vector<MarketData> market_data_;
+  MarketDataView market_data_;
   std::vector<double> schedule_;
+  std::vector<double> capacity_;
+  double unfilled_volume_ = 0.0;
 };
 
 }  // namespace lvt
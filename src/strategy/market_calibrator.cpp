@@ -0,0 +1,118 @@
+#include "strategy/market_calibrator.h"
+#include <cmath>
+#include <filesystem>
+#include <iostream>
+#include "market/market_data_reader.h"
+#include "market/timestamp.h"
+#include "util/thread_pool.h"
+
+namespace lvt {
+
+AlmgrenKrissParams CalibrationResult::ToParameters(double lambda) const {
+  AlmgrenKrissParams params;
+  params.sigma = sigma;
+  params.lambda = lambda;
+  if (mean_volume > 0) params.eta = spread() / (0.01 * mean_volume);
+  if (daily_volume > 0) params.gamma = spread() / (0.1 * daily_volume);
+  return params;
+}
+
+MarketCalibrator::MarketCalibrator() { Reset(); }
+
+void MarketCalibrator::Reset() {
+  price_ = RunningStats();
+  volume_ = RunningStats();
+  change_ = RunningStats();
+  abs_change_ = RunningStats();
+  autocov_ = RunningCovariance();
+  total_volume_ = 0.0;
+  days_ = 0;
+  last_day_ = 0;
+  last_price_ = 0.0;
+  last_change_ = 0.0;
+  has_last_change_ = false;
+}
+
+void MarketCalibrator::Add(const MarketData& bar) {
+  const int64_t day = EpochDay(bar.epoch_ns);
+  const bool same_day = price_.count() > 0 && day == last_day_;
+  if (!same_day) {
+    ++days_;
+    has_last_change_ = false;
+  } else {
+    const double change = bar.price - last_price_;
+    change_.Add(change);
+    abs_change_.Add(std::abs(change));
+    if (has_last_change_) autocov_.Add(last_change_, change);
+    last_change_ = change;
+    has_last_change_ = true;
+  }
+  price_.Add(bar.price);
+  volume_.Add(bar.volume);
+  total_volume_ += bar.volume;
+  last_day_ = day;
+  last_price_ = bar.price;
+}
+
+void MarketCalibrator::Add(MarketDataView bars) {
+  for (size_t i = 0; i < bars.size(); ++i) Add(bars.Row(i));
+}
+
+CalibrationResult MarketCalibrator::Result() const {
+  CalibrationResult result;
+  result.bars = price_.count();
+  result.days = days_;
+  result.sigma = change_.stddev();
+  const double autocov = autocov_.covariance();
+  result.roll_spread = autocov < 0 ? 2.0 * std::sqrt(-autocov) : 0.0;
+  result.mean_abs_change = abs_change_.mean();
+  result.mean_price = price_.mean();
+  result.mean_volume = volume_.mean();
+  result.volume_stddev = volume_.stddev();
+  result.daily_volume = days_ > 0 ? total_volume_ / days_ : 0.0;
+  return result;
+}
+
+bool CalibrateFiles(std::span<const std::string> paths, ThreadPool* pool,
+                    std::vector<CalibrationResult>* results) {
+  results->assign(paths.size(), CalibrationResult());
+  std::vector<char> ok(paths.size(), 0);
+  auto calibrate = [&](size_t i) {
+    MarketDataReader reader(paths[i]);
+    MarketCalibrator calibrator;
+    ok[i] = reader.ForEachBatch([&calibrator](MarketDataView batch) {
+      calibrator.Add(batch);
+      return true;
+    });
+    if (!ok[i]) {
+      std::cerr << "[Error] Failed to read market data from " << paths[i] << std::endl;
+      return;
+    }
+    (*results)[i] = calibrator.Result();
+  };
+  if (pool) {
+    pool->ParallelFor(paths.size(), calibrate);
+  } else {
+    for (size_t i = 0; i < paths.size(); ++i) calibrate(i);
+  }
+  for (char file_ok : ok) {
+    if (!file_ok) return false;
+  }
+  return true;
+}
+
+void WriteCalibration(std::span<const std::string> paths, std::span<const CalibrationResult> results,
+                      std::ostream& out) {
+  out << "symbol,bars,days,sigma,roll_spread,mean_abs_change,mean_price,mean_volume,"
+         "volume_stddev,daily_volume,eta,gamma\n";
+  for (size_t i = 0; i < results.size() && i < paths.size(); ++i) {
+    const CalibrationResult& r = results[i];
+    const AlmgrenKrissParams params = r.ToParameters(AlmgrenKrissParams().lambda);
+    out << std::filesystem::path(paths[i]).stem().string() << "," << r.bars << "," << r.days << ","
+        << r.sigma << "," << r.roll_spread << "," << r.mean_abs_change << "," << r.mean_price << ","
+        << r.mean_volume << "," << r.volume_stddev << "," << r.daily_volume << "," << params.eta
+        << "," << params.gamma << "\n";
+  }
+}
+
+}  // namespace lvt
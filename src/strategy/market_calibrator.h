@@ -0,0 +1,82 @@
+#ifndef LARGE_VOLUME_TRADING_MARKET_CALIBRATOR_H_
+#define LARGE_VOLUME_TRADING_MARKET_CALIBRATOR_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <span>
+#include <string>
+#include <vector>
+#include "market/market_data.h"
+#include "market/market_data_columns.h"
+#include "strategy/almgren_kriss_model.h"
+#include "util/running_stats.h"
+
+namespace lvt {
+
+class ThreadPool;
+
+struct CalibrationResult {
+  size_t bars = 0;
+  size_t days = 0;
+  double sigma = 0.0;            // Std dev of bar-to-bar price changes.
+  double roll_spread = 0.0;      // 2 sqrt(-cov(dp_t, dp_t-1)); 0 if the cov is >= 0.
+  double mean_abs_change = 0.0;  // Mean |dp|, the fallback spread proxy.
+  double mean_price = 0.0;
+  double mean_volume = 0.0;  // Per bar.
+  double volume_stddev = 0.0;
+  double daily_volume = 0.0;
+
+  // Roll's spread when the price changes show bid-ask bounce, else the
+  // mean absolute price change.
+  double spread() const { return roll_spread > 0 ? roll_spread : mean_abs_change; }
+
+  // Almgren-Chriss parameters for bar-length intervals, using the rules of
+  // thumb from their paper: trading 1% of the typical volume per bar moves
+  // the price by one spread temporarily (eta), and trading 10% of a day's
+  // volume moves it by one spread permanently (gamma). Risk aversion is a
+  // preference, not a market property, so `lambda` is passed through.
+  AlmgrenKrissParams ToParameters(double lambda) const;
+};
+
+// Estimates volatility, spread proxies and volume statistics in one pass
+// over time-ordered bars, with Welford accumulators (constant memory, so it
+// works batch by batch on streamed input). Price changes across a day
+// boundary are skipped so overnight gaps do not count as volatility.
+class MarketCalibrator {
+ public:
+  MarketCalibrator();
+
+  void Reset();
+  void Add(const MarketData& bar);
+  void Add(MarketDataView bars);
+  CalibrationResult Result() const;
+
+ private:
+  RunningStats price_;
+  RunningStats volume_;
+  RunningStats change_;
+  RunningStats abs_change_;
+  RunningCovariance autocov_;
+  double total_volume_;
+  size_t days_;
+  int64_t last_day_;
+  double last_price_;
+  double last_change_;
+  bool has_last_change_;
+};
+
+// Calibrates every file in one streaming pass each (MarketDataReader), in
+// parallel on `pool` when one is given. results[i] belongs to paths[i].
+// Returns false (with an error message) if any file could not be read.
+bool CalibrateFiles(std::span<const std::string> paths, ThreadPool* pool,
+                    std::vector<CalibrationResult>* results);
+
+// Writes a CSV table with one row per file: the statistics and the derived
+// eta and gamma.
+void WriteCalibration(std::span<const std::string> paths, std::span<const CalibrationResult> results,
+                      std::ostream& out);
+
+}  // namespace lvt
+
+#endif  // LARGE_VOLUME_TRADING_MARKET_CALIBRATOR_H_
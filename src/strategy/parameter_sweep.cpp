@@ -0,0 +1,132 @@
+#include "strategy/parameter_sweep.h"
+#include <charconv>
+#include <fstream>
+#include <iostream>
+#include <system_error>
+#include "strategy/almgren_kriss_model.h"
+#include "util/thread_pool.h"
+
+namespace lvt {
+
+bool ParseParameterValues(std::string_view text, std::vector<double>* values) {
+  std::vector<double> parsed;
+  while (true) {
+    size_t comma = text.find(',');
+    std::string_view field = text.substr(0, comma);
+    while (!field.empty() && (field.front() == ' ' || field.front() == '\t')) field.remove_prefix(1);
+    while (!field.empty() && (field.back() == ' ' || field.back() == '\t' || field.back() == '\r')) {
+      field.remove_suffix(1);
+    }
+    // At most one '+', which from_chars does not accept itself.
+    if (!field.empty() && field.front() == '+') {
+      field.remove_prefix(1);
+      if (!field.empty() && field.front() == '-') return false;
+    }
+    double value;
+    auto result = std::from_chars(field.data(), field.data() + field.size(), value);
+    if (field.empty() || result.ec != std::errc() || result.ptr != field.data() + field.size()) {
+      return false;
+    }
+    parsed.push_back(value);
+    if (comma == std::string_view::npos) break;
+    text.remove_prefix(comma + 1);
+  }
+  *values = std::move(parsed);
+  return true;
+}
+
+std::vector<AlmgrenKrissParams> MakeParameterGrid(std::span<const double> etas,
+                                                  std::span<const double> gammas,
+                                                  std::span<const double> sigmas,
+                                                  std::span<const double> lambdas) {
+  std::vector<AlmgrenKrissParams> grid;
+  grid.reserve(etas.size() * gammas.size() * sigmas.size() * lambdas.size());
+  for (double eta : etas) {
+    for (double gamma : gammas) {
+      for (double sigma : sigmas) {
+        for (double lambda : lambdas) grid.push_back({eta, gamma, sigma, lambda});
+      }
+    }
+  }
+  return grid;
+}
+
+bool LoadParameterSets(const std::string& path, std::vector<AlmgrenKrissParams>* sets) {
+  std::ifstream file(path);
+  if (!file.is_open()) {
+    std::cerr << "[Error] Cannot open file: " << path << std::endl;
+    return false;
+  }
+  std::vector<AlmgrenKrissParams> loaded;
+  std::string line;
+  size_t line_number = 0;
+  while (std::getline(file, line)) {
+    ++line_number;
+    if (line.find_first_not_of(" \t\r") == std::string::npos) continue;
+    if (line_number == 1 && line.find("eta") != std::string::npos) continue;
+    std::vector<double> values;
+    if (!ParseParameterValues(line, &values) || values.size() != 4) {
+      std::cerr << "[Error] Invalid parameter set at " << path << ":" << line_number << std::endl;
+      return false;
+    }
+    loaded.push_back({values[0], values[1], values[2], values[3]});
+  }
+  *sets = std::move(loaded);
+  return true;
+}
+
+ParameterSweep::ParameterSweep() : total_volume_(0), simulate_fills_(false) {}
+
+void ParameterSweep::SetSessions(std::vector<std::span<const double>> sessions,
+                                 double total_volume) {
+  sessions_ = std::move(sessions);
+  total_volume_ = total_volume;
+}
+
+void ParameterSweep::SetFillModel(MarketDataView bars, const FillModel& model) {
+  simulate_fills_ = true;
+  fill_bars_ = bars;
+  fill_model_ = model;
+}
+
+void ParameterSweep::Run(std::span<const AlmgrenKrissParams> sets, ThreadPool* pool) {
+  results_.assign(sets.size(), SweepResult());
+  const FillSimulator fill_simulator(fill_model_);
+  auto evaluate = [&](size_t i) {
+    const AlmgrenKrissParams& p = sets[i];
+    AlmgrenKrissModel model;
+    model.SetParameters(p.eta, p.gamma, p.sigma, p.lambda);
+    model.SetSessions(sessions_, total_volume_);
+    model.ComputeMultiDaySchedule();
+    results_[i] = {p, model.ExpectedCost(), model.CostVariance(), FillSummary()};
+    if (simulate_fills_) {
+      const auto& schedule = model.GetSchedule();
+      std::vector<double> fills(schedule.size());
+      std::vector<double> fill_prices(schedule.size());
+      fill_simulator.Simulate(fill_bars_, schedule, fills, fill_prices);
+      results_[i].fills = fill_simulator.Summarize(fill_bars_, fills, fill_prices);
+    }
+  };
+  if (pool != nullptr) {
+    pool->ParallelFor(sets.size(), evaluate);
+  } else {
+    for (size_t i = 0; i < sets.size(); ++i) evaluate(i);
+  }
+}
+
+const std::vector<SweepResult>& ParameterSweep::GetResults() const {
+  return results_;
+}
+
+void ParameterSweep::WriteResults(std::ostream& out) const {
+  out << "eta,gamma,sigma,lambda,expected_cost,variance"
+      << (simulate_fills_ ? ",filled_volume,impact_cost\n" : "\n");
+  for (const auto& r : results_) {
+    out << r.params.eta << "," << r.params.gamma << "," << r.params.sigma << ","
+        << r.params.lambda << "," << r.expected_cost << "," << r.variance;
+    if (simulate_fills_) out << "," << r.fills.filled_volume << "," << r.fills.impact_cost;
+    out << "\n";
+  }
+}
+
+}  // namespace lvt
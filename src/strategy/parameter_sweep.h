@@ -0,0 +1,70 @@
+#ifndef LARGE_VOLUME_TRADING_PARAMETER_SWEEP_H_
+#define LARGE_VOLUME_TRADING_PARAMETER_SWEEP_H_
+
+#include <ostream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "market/market_data_columns.h"
+#include "order/fill_simulator.h"
+#include "strategy/almgren_kriss_model.h"
+
+namespace lvt {
+
+class ThreadPool;
+
+struct SweepResult {
+  AlmgrenKrissParams params;
+  double expected_cost = 0.0;
+  double variance = 0.0;
+  // Realized fills of the schedule; only set after SetFillModel().
+  FillSummary fills;
+};
+
+// Parses a comma-separated list of numbers such as "0.1,1,10".
+// Returns false (leaving `values` untouched) on an empty or malformed list.
+bool ParseParameterValues(std::string_view text, std::vector<double>* values);
+
+// Cartesian product of the value lists, with lambda varying fastest.
+std::vector<AlmgrenKrissParams> MakeParameterGrid(std::span<const double> etas,
+                                                  std::span<const double> gammas,
+                                                  std::span<const double> sigmas,
+                                                  std::span<const double> lambdas);
+
+// Reads parameter sets from a CSV file with "eta,gamma,sigma,lambda" rows.
+// A header line and blank lines are skipped; any other bad row is an error.
+bool LoadParameterSets(const std::string& path, std::vector<AlmgrenKrissParams>* sets);
+
+// Evaluates many parameter sets against one loaded data set. Every set is
+// solved independently, so the work is spread over a thread pool.
+class ParameterSweep {
+ public:
+  ParameterSweep();
+  // Non-owning views, as for AlmgrenKrissModel::SetSessions.
+  void SetSessions(std::vector<std::span<const double>> sessions, double total_volume);
+  // Also realizes every schedule against `bars` (the sessions' bars back to
+  // back, interval k in bar k) with FillSimulator::Simulate, so the results
+  // include the participation cap and impact of `model`.
+  void SetFillModel(MarketDataView bars, const FillModel& model);
+
+  // Fills GetResults() with one entry per set, in the order given.
+  void Run(std::span<const AlmgrenKrissParams> sets, ThreadPool* pool = nullptr);
+  const std::vector<SweepResult>& GetResults() const;
+
+  // Writes "eta,gamma,sigma,lambda,expected_cost,variance" rows with a
+  // header, plus "filled_volume,impact_cost" after SetFillModel().
+  void WriteResults(std::ostream& out) const;
+
+ private:
+  std::vector<std::span<const double>> sessions_;
+  double total_volume_;
+  bool simulate_fills_;
+  MarketDataView fill_bars_;
+  FillModel fill_model_;
+  std::vector<SweepResult> results_;
+};
+
+}  // namespace lvt
+
+#endif  // LARGE_VOLUME_TRADING_PARAMETER_SWEEP_H_
@@ -1,28 +1,73 @@
 #include "strategy/vwap_calculator.h"
+#include "market/timestamp.h"
+#include "util/instrumentation.h"
 
 namespace lvt {
 
 VWAPCalculator::VWAPCalculator() = default;
 
-void VWAPCalculator::SetMarketData(const std::vector<MarketData>& market_data) {
+void VWAPCalculator::SetMarketData(MarketDataView market_data) {
   market_data_ = market_data;
 }
 
 void VWAPCalculator::ComputeVWAPSchedule(double total_volume) {
+  LVT_STAGE_TIMER(Stage::kVwapSchedule);
   schedule_.clear();
   if (market_data_.empty() || total_volume <= 0) {
     return;
   }
+  const auto volume = market_data_.volume();
   double sum_volume = 0.0;
-  for (const auto& m : market_data_) sum_volume += m.volume;
+  for (double v : volume) sum_volume += v;
   if (sum_volume <= 0) return;
-  for (const auto& m : market_data_) {
-    schedule_.push_back(total_volume * (m.volume / sum_volume));
+  schedule_.reserve(volume.size());
+  for (double v : volume) {
+    schedule_.push_back(total_volume * (v / sum_volume));
   }
 }
 
+void VWAPCalculator::ComputeProfileSchedule(const VolumeProfile& profile, int64_t session_start_ns,
+                                            int64_t session_end_ns, double total_volume) {
+  LVT_STAGE_TIMER(Stage::kVwapSchedule);
+  schedule_.clear();
+  if (profile.empty() || total_volume <= 0 || session_end_ns <= session_start_ns) return;
+  const int64_t start = FloorToMinute(session_start_ns);
+  const size_t minutes = static_cast<size_t>((session_end_ns - start + kNanosPerMinute - 1) / kNanosPerMinute);
+  schedule_.reserve(minutes);
+  double sum_volume = 0.0;
+  for (size_t i = 0; i < minutes; ++i) {
+    schedule_.push_back(profile.ExpectedVolume(start + static_cast<int64_t>(i) * kNanosPerMinute));
+    sum_volume += schedule_.back();
+  }
+  if (sum_volume <= 0) {
+    schedule_.clear();
+    return;
+  }
+  for (double& v : schedule_) v = total_volume * (v / sum_volume);
+}
+
 const std::vector<double>& VWAPCalculator::GetSchedule() const {
   return schedule_;
 }
 
+bool VWAPCalculator::ComputeVWAPScheduleStreaming(MarketDataReader* reader, double total_volume,
+                                                  const ScheduleSink& sink) {
+  if (total_volume <= 0) return false;
+  double sum_volume = 0.0;
+  bool ok = reader->Open() && reader->ForEachBatch([&](MarketDataView bars) {
+    for (double v : bars.volume()) sum_volume += v;
+    return true;
+  });
+  if (!ok || sum_volume <= 0) return false;
+
+  std::vector<double> slice;
+  return reader->Open() && reader->ForEachBatch([&](MarketDataView bars) {
+    const auto volume = bars.volume();
+    slice.resize(volume.size());
+    for (size_t i = 0; i < volume.size(); ++i) slice[i] = total_volume * (volume[i] / sum_volume);
+    sink(bars, slice);
+    return true;
+  });
+}
+
 }  // namespace lvt
@@ -1,21 +1,44 @@
 #ifndef LARGE_VOLUME_TRADING_VWAP_CALCULATOR_H_
 #define LARGE_VOLUME_TRADING_VWAP_CALCULATOR_H_
 
-#include "market_simulator.h"
+#include "market/market_data_columns.h"
+#include "market/market_data_reader.h"
+#include "market/volume_profile.h"
+#include <cstdint>
+#include <functional>
+#include <span>
 #include <vector>
-#include <string>
 
 namespace lvt {
 
 class VWAPCalculator {
  public:
   VWAPCalculator();
-  void SetMarketData(const std::vector<MarketData>& market_data);
+  // Keeps a non-owning view; the data must stay alive while the calculator uses it.
+  void SetMarketData(MarketDataView market_data);
   void ComputeVWAPSchedule(double total_volume);
   const std::vector<double>& GetSchedule() const;
 
+  // Forward-looking schedule for a session that has not traded yet: one
+  // slice per minute in [session_start_ns, session_end_ns) (the start is
+  // rounded down to a minute), weighted by the historical `profile`. Slice i
+  // covers the minute starting at session_start + i minutes. The schedule is
+  // empty if the profile expects no volume in the window.
+  void ComputeProfileSchedule(const VolumeProfile& profile, int64_t session_start_ns,
+                              int64_t session_end_ns, double total_volume);
+
+  // Receives one batch of bars together with its slice of the schedule.
+  using ScheduleSink = std::function<void(MarketDataView bars, std::span<const double> schedule)>;
+
+  // Two-pass VWAP over a stream that need not fit in memory: the first pass
+  // totals market volume, the second allocates `total_volume` batch by batch
+  // and hands every slice to `sink`. Memory use is one batch whatever the
+  // file size. Returns false if the reader fails or there is no volume.
+  static bool ComputeVWAPScheduleStreaming(MarketDataReader* reader, double total_volume,
+                                           const ScheduleSink& sink);
+
  private:
-  std::vector<MarketData> market_data_;
+  MarketDataView market_data_;
   std::vector<double> schedule_;
 };
 
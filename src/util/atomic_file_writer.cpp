@@ -0,0 +1,51 @@
+#include "util/atomic_file_writer.h"
+#include <cstdio>
+#include <filesystem>
+#include <system_error>
+
+namespace lvt {
+
+AtomicFileWriter::~AtomicFileWriter() { Abandon(); }
+
+bool AtomicFileWriter::Open(const std::string& path) {
+  Abandon();
+  file_.clear();
+  file_.open(path + ".tmp", std::ios::binary | std::ios::trunc);
+  if (!file_.is_open()) return false;
+  path_ = path;
+  tmp_path_ = path + ".tmp";
+  return true;
+}
+
+bool AtomicFileWriter::Write(const void* data, size_t bytes) {
+  file_.write(static_cast<const char*>(data), bytes);
+  return file_.good();
+}
+
+bool AtomicFileWriter::Commit() {
+  if (!file_.is_open() || !file_.good()) {
+    Abandon();
+    return false;
+  }
+  file_.close();
+  if (file_.fail()) {
+    Abandon();
+    return false;
+  }
+  std::error_code ec;
+  std::filesystem::rename(tmp_path_, path_, ec);
+  if (ec) {
+    Abandon();
+    return false;
+  }
+  tmp_path_.clear();
+  return true;
+}
+
+void AtomicFileWriter::Abandon() {
+  if (file_.is_open()) file_.close();
+  if (!tmp_path_.empty()) std::remove(tmp_path_.c_str());
+  tmp_path_.clear();
+}
+
+}  // namespace lvt
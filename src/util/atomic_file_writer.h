@@ -0,0 +1,44 @@
+#ifndef LARGE_VOLUME_TRADING_ATOMIC_FILE_WRITER_H_
+#define LARGE_VOLUME_TRADING_ATOMIC_FILE_WRITER_H_
+
+#include <cstddef>
+#include <fstream>
+#include <string>
+
+namespace lvt {
+
+// Builds a file under "<path>.tmp" and renames it into place on Commit(), so
+// readers never see a partial file. The temporary file is removed when the
+// writer is abandoned, destroyed before Commit(), or Commit() fails.
+class AtomicFileWriter {
+ public:
+  AtomicFileWriter() = default;
+  ~AtomicFileWriter();
+  AtomicFileWriter(const AtomicFileWriter&) = delete;
+  AtomicFileWriter& operator=(const AtomicFileWriter&) = delete;
+
+  // Creates or truncates the temporary file, abandoning any open one.
+  // Returns false if it cannot be created.
+  bool Open(const std::string& path);
+  bool is_open() const { return file_.is_open(); }
+
+  // Returns false once any write has failed.
+  bool Write(const void* data, size_t bytes);
+  // The temporary file, for writers that seek.
+  std::ofstream& stream() { return file_; }
+
+  // Closes the file and renames it to the path given to Open(). Returns
+  // false, leaving no file behind, if a write, the close or the rename failed.
+  bool Commit();
+  // Closes and removes the temporary file.
+  void Abandon();
+
+ private:
+  std::ofstream file_;
+  std::string path_;
+  std::string tmp_path_;
+};
+
+}  // namespace lvt
+
+#endif  // LARGE_VOLUME_TRADING_ATOMIC_FILE_WRITER_H_
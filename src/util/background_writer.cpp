@@ -0,0 +1,60 @@
+#include "util/background_writer.h"
+#include <utility>
+
+namespace lvt {
+
+BackgroundWriter::BackgroundWriter(size_t max_pending_bytes)
+    : max_pending_bytes_(max_pending_bytes),
+      pending_bytes_(0),
+      busy_(false),
+      failed_(false),
+      stopping_(false),
+      thread_([this] { Loop(); }) {}
+
+BackgroundWriter::~BackgroundWriter() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  work_cv_.notify_one();
+  thread_.join();
+}
+
+void BackgroundWriter::Submit(std::function<bool()> task, size_t bytes) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  // A task larger than the limit is still accepted once the queue is empty.
+  done_cv_.wait(lock, [&] { return pending_bytes_ == 0 || pending_bytes_ + bytes <= max_pending_bytes_; });
+  tasks_.push_back({std::move(task), bytes});
+  pending_bytes_ += bytes;
+  lock.unlock();
+  work_cv_.notify_one();
+}
+
+bool BackgroundWriter::Drain() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  done_cv_.wait(lock, [&] { return tasks_.empty() && !busy_; });
+  const bool ok = !failed_;
+  failed_ = false;
+  return ok;
+}
+
+void BackgroundWriter::Loop() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    work_cv_.wait(lock, [&] { return stopping_ || !tasks_.empty(); });
+    if (tasks_.empty()) return;
+    Task task = std::move(tasks_.front());
+    tasks_.pop_front();
+    busy_ = true;
+    lock.unlock();
+    const bool ok = task.run();
+    task.run = nullptr;  // Free the buffer before waking producers.
+    lock.lock();
+    busy_ = false;
+    if (!ok) failed_ = true;
+    pending_bytes_ -= task.bytes;
+    done_cv_.notify_all();
+  }
+}
+
+}  // namespace lvt
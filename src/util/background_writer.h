@@ -0,0 +1,56 @@
+#ifndef LARGE_VOLUME_TRADING_BACKGROUND_WRITER_H_
+#define LARGE_VOLUME_TRADING_BACKGROUND_WRITER_H_
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace lvt {
+
+// One thread that runs output tasks (typically "write this buffer") in
+// submission order, so producers can hand finished buffers off and go on
+// computing. Submit() blocks while more than `max_pending_bytes` of queued
+// tasks are outstanding, which bounds the memory held by formatted output
+// that the disk has not caught up with.
+class BackgroundWriter {
+ public:
+  explicit BackgroundWriter(size_t max_pending_bytes = size_t{64} << 20);
+  // Runs the remaining tasks, then joins the thread.
+  ~BackgroundWriter();
+  BackgroundWriter(const BackgroundWriter&) = delete;
+  BackgroundWriter& operator=(const BackgroundWriter&) = delete;
+
+  // Queues `task`; `bytes` is what it holds, for the pending limit. A task
+  // reports failure by returning false. Safe to call from any thread.
+  void Submit(std::function<bool()> task, size_t bytes);
+
+  // Waits until every task queued so far has run. Returns false if any task
+  // failed since the previous Drain().
+  bool Drain();
+
+ private:
+  struct Task {
+    std::function<bool()> run;
+    size_t bytes;
+  };
+
+  void Loop();
+
+  const size_t max_pending_bytes_;
+  std::mutex mutex_;
+  std::condition_variable work_cv_;
+  std::condition_variable done_cv_;
+  std::deque<Task> tasks_;
+  size_t pending_bytes_;
+  bool busy_;
+  bool failed_;
+  bool stopping_;
+  std::thread thread_;
+};
+
+}  // namespace lvt
+
+#endif  // LARGE_VOLUME_TRADING_BACKGROUND_WRITER_H_
@@ -0,0 +1,120 @@
+#include "util/instrumentation.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+
+namespace lvt {
+
+namespace {
+
+constexpr const char* kStageNames[] = {
+    "load",        "parse",       "vwap_schedule",     "optimal_speed_schedule", "almgren_kriss_schedule",
+    "issue_order", "submit_order", "drain_submissions", "output",
+};
+static_assert(std::size(kStageNames) == static_cast<size_t>(Stage::kCount));
+
+LatencyHistogram g_stage_histograms[static_cast<size_t>(Stage::kCount)];
+
+}  // namespace
+
+size_t LatencyHistogram::BucketIndex(uint64_t value) {
+  if (value < kSubBuckets) return static_cast<size_t>(value);
+  // The top kSubBucketBits + 1 bits select the bucket: the leading one
+  // gives the power of two, the rest the sub-bucket within it.
+  const int shift = std::bit_width(value) - 1 - kSubBucketBits;
+  return static_cast<size_t>(shift + 1) * kSubBuckets + static_cast<size_t>((value >> shift) - kSubBuckets);
+}
+
+uint64_t LatencyHistogram::BucketLowerBound(size_t index) {
+  if (index < kSubBuckets) return index;
+  const size_t shift = index / kSubBuckets - 1;
+  return static_cast<uint64_t>(kSubBuckets + index % kSubBuckets) << shift;
+}
+
+uint64_t LatencyHistogram::BucketWidth(size_t index) {
+  return index < kSubBuckets ? 1 : uint64_t{1} << (index / kSubBuckets - 1);
+}
+
+void LatencyHistogram::Record(uint64_t value) {
+  buckets_[BucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+  count_.fetch_add(1, std::memory_order_relaxed);
+  total_.fetch_add(value, std::memory_order_relaxed);
+  uint64_t seen = min_.load(std::memory_order_relaxed);
+  while (value < seen && !min_.compare_exchange_weak(seen, value, std::memory_order_relaxed)) {
+  }
+  seen = max_.load(std::memory_order_relaxed);
+  while (value > seen && !max_.compare_exchange_weak(seen, value, std::memory_order_relaxed)) {
+  }
+}
+
+void LatencyHistogram::Merge(const LatencyHistogram& other) {
+  if (other.count() == 0) return;
+  for (size_t i = 0; i < kBucketCount; ++i) {
+    const uint64_t n = other.buckets_[i].load(std::memory_order_relaxed);
+    if (n > 0) buckets_[i].fetch_add(n, std::memory_order_relaxed);
+  }
+  count_.fetch_add(other.count(), std::memory_order_relaxed);
+  total_.fetch_add(other.total(), std::memory_order_relaxed);
+  const uint64_t other_min = other.min();
+  uint64_t seen = min_.load(std::memory_order_relaxed);
+  while (other_min < seen && !min_.compare_exchange_weak(seen, other_min, std::memory_order_relaxed)) {
+  }
+  const uint64_t other_max = other.max();
+  seen = max_.load(std::memory_order_relaxed);
+  while (other_max > seen && !max_.compare_exchange_weak(seen, other_max, std::memory_order_relaxed)) {
+  }
+}
+
+void LatencyHistogram::Reset() {
+  for (auto& bucket : buckets_) bucket.store(0, std::memory_order_relaxed);
+  count_.store(0, std::memory_order_relaxed);
+  total_.store(0, std::memory_order_relaxed);
+  min_.store(std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed);
+  max_.store(0, std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::Percentile(double q) const {
+  const uint64_t n = count();
+  if (n == 0) return 0;
+  const double clamped = std::clamp(q, 0.0, 1.0);
+  const uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(clamped * n)));
+  // The extremes are tracked exactly.
+  if (rank == 1) return min();
+  if (rank >= n) return max();
+  uint64_t seen = 0;
+  for (size_t i = 0; i < kBucketCount; ++i) {
+    seen += buckets_[i].load(std::memory_order_relaxed);
+    if (seen >= rank) {
+      const uint64_t mid = BucketLowerBound(i) + (BucketWidth(i) - 1) / 2;
+      return std::clamp(mid, min(), max());
+    }
+  }
+  return max();
+}
+
+const char* StageName(Stage stage) {
+  const size_t i = static_cast<size_t>(stage);
+  return i < std::size(kStageNames) ? kStageNames[i] : "unknown";
+}
+
+LatencyHistogram& StageHistogram(Stage stage) {
+  return g_stage_histograms[static_cast<size_t>(stage)];
+}
+
+void ResetStageStats() {
+  for (auto& histogram : g_stage_histograms) histogram.Reset();
+}
+
+void WriteStageStats(std::ostream& out) {
+  out << "stage,count,total_ms,mean_us,p50_us,p99_us,p999_us,max_us\n";
+  for (size_t i = 0; i < static_cast<size_t>(Stage::kCount); ++i) {
+    const LatencyHistogram& h = g_stage_histograms[i];
+    if (h.count() == 0) continue;
+    out << kStageNames[i] << "," << h.count() << "," << h.total() / 1e6 << "," << h.mean() / 1e3 << ","
+        << h.Percentile(0.5) / 1e3 << "," << h.Percentile(0.99) / 1e3 << ","
+        << h.Percentile(0.999) / 1e3 << "," << h.max() / 1e3 << "\n";
+  }
+}
+
+}  // namespace lvt
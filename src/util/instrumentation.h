@@ -0,0 +1,127 @@
+#ifndef LARGE_VOLUME_TRADING_INSTRUMENTATION_H_
+#define LARGE_VOLUME_TRADING_INSTRUMENTATION_H_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+namespace lvt {
+
+// Log-bucketed latency histogram in the style of HdrHistogram: values below
+// 2^kSubBucketBits get one bucket each, larger values are split into
+// 2^kSubBucketBits buckets per power of two, so every recorded value is
+// known to within ~3% over the whole uint64 range with a fixed 15 KB table.
+// Record() is lock-free (relaxed atomics) and safe from any thread.
+class LatencyHistogram {
+ public:
+  static constexpr int kSubBucketBits = 5;
+  static constexpr size_t kSubBuckets = size_t{1} << kSubBucketBits;
+  static constexpr size_t kBucketCount = (64 - kSubBucketBits + 1) * kSubBuckets;
+
+  LatencyHistogram() { Reset(); }
+  LatencyHistogram(const LatencyHistogram&) = delete;
+  LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+  void Record(uint64_t value);
+  // Adds the samples of `other`; not atomic with respect to concurrent
+  // Record() calls on `other`.
+  void Merge(const LatencyHistogram& other);
+  void Reset();
+
+  uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+  uint64_t total() const { return total_.load(std::memory_order_relaxed); }
+  // 0 when empty.
+  uint64_t min() const { return count() > 0 ? min_.load(std::memory_order_relaxed) : 0; }
+  uint64_t max() const { return max_.load(std::memory_order_relaxed); }
+  double mean() const { return count() > 0 ? static_cast<double>(total()) / count() : 0.0; }
+
+  // Value at quantile q in [0, 1]: the middle of the bucket holding the
+  // ceil(q * count)-th smallest sample, clamped to [min(), max()]; the
+  // first and last ranks return min() and max() exactly. 0 when empty.
+  uint64_t Percentile(double q) const;
+
+  static size_t BucketIndex(uint64_t value);
+  static uint64_t BucketLowerBound(size_t index);
+  static uint64_t BucketWidth(size_t index);
+
+ private:
+  std::array<std::atomic<uint64_t>, kBucketCount> buckets_;
+  std::atomic<uint64_t> count_;
+  std::atomic<uint64_t> total_;
+  std::atomic<uint64_t> min_;
+  std::atomic<uint64_t> max_;
+};
+
+// Hot-path stages timed by LVT_STAGE_TIMER.
+enum class Stage : uint8_t {
+  kLoad,             // MarketSimulator::Load(), whole file to columns.
+  kParse,            // CSV text to columns, part of kLoad.
+  kVwapSchedule,     // VWAPCalculator schedule computation.
+  kOptimalSpeed,     // LimitOrderSpeedModel schedule computation.
+  kAlmgrenKriss,     // AlmgrenKrissModel, one call per solved session.
+  kIssueOrder,       // OrderManager::IssueOrder().
+  kSubmitOrder,      // OrderManager::SubmitOrder(), including waits on a full ring.
+  kDrainSubmissions, // OrderManager::DrainSubmissions().
+  kOutput,           // Writing results in the command-line tool.
+  kCount,
+};
+
+const char* StageName(Stage stage);
+
+// Process-wide histogram of `stage` durations in nanoseconds.
+LatencyHistogram& StageHistogram(Stage stage);
+void ResetStageStats();
+
+// Timers only sample the clock while this is on (off by default), so an
+// instrumented build costs one relaxed load per timed scope unless a run
+// asks for statistics.
+inline std::atomic<bool> g_stage_timing_enabled{false};
+inline void SetStageTimingEnabled(bool enabled) {
+  g_stage_timing_enabled.store(enabled, std::memory_order_relaxed);
+}
+inline bool StageTimingEnabled() { return g_stage_timing_enabled.load(std::memory_order_relaxed); }
+
+// Writes one CSV row per stage that recorded anything:
+// stage,count,total_ms,mean_us,p50_us,p99_us,p999_us,max_us.
+void WriteStageStats(std::ostream& out);
+
+// Records the lifetime of the scope into StageHistogram(stage) when timing
+// is enabled at construction.
+class ScopedStageTimer {
+ public:
+  explicit ScopedStageTimer(Stage stage) : stage_(stage), active_(StageTimingEnabled()) {
+    if (active_) start_ = std::chrono::steady_clock::now();
+  }
+  ~ScopedStageTimer() {
+    if (!active_) return;
+    const auto elapsed = std::chrono::steady_clock::now() - start_;
+    StageHistogram(stage_).Record(static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+  }
+  ScopedStageTimer(const ScopedStageTimer&) = delete;
+  ScopedStageTimer& operator=(const ScopedStageTimer&) = delete;
+
+ private:
+  Stage stage_;
+  bool active_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+}  // namespace lvt
+
+// Times the rest of the enclosing scope as `stage`. Expands to nothing
+// unless the build defines LVT_ENABLE_INSTRUMENTATION (CMake option
+// LVT_INSTRUMENTATION).
+#ifdef LVT_ENABLE_INSTRUMENTATION
+#define LVT_STAGE_TIMER_CONCAT_INNER(a, b) a##b
+#define LVT_STAGE_TIMER_CONCAT(a, b) LVT_STAGE_TIMER_CONCAT_INNER(a, b)
+#define LVT_STAGE_TIMER(stage) \
+  ::lvt::ScopedStageTimer LVT_STAGE_TIMER_CONCAT(lvt_stage_timer_, __LINE__)(stage)
+#else
+#define LVT_STAGE_TIMER(stage) static_cast<void>(0)
+#endif
+
+#endif  // LARGE_VOLUME_TRADING_INSTRUMENTATION_H_
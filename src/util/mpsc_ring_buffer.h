@@ -0,0 +1,82 @@
+#ifndef LARGE_VOLUME_TRADING_MPSC_RING_BUFFER_H_
+#define LARGE_VOLUME_TRADING_MPSC_RING_BUFFER_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
+namespace lvt {
+
+// Bounded lock-free queue for many producers and one consumer (Vyukov's
+// sequence-numbered ring). Every slot carries a sequence number telling
+// whether it is free for the producer of ticket `pos` (seq == pos) or holds
+// that producer's value for the consumer (seq == pos + 1). Producers claim
+// tickets with a CAS on the tail; the consumer needs no atomics of its own.
+template <typename T>
+class MpscRingBuffer {
+  static_assert(std::is_trivially_copyable_v<T>, "slots are copied without locks");
+
+ public:
+  // `capacity` is rounded up to a power of two (at least 2).
+  explicit MpscRingBuffer(size_t capacity) {
+    size_t size = 2;
+    while (size < capacity) size <<= 1;
+    mask_ = size - 1;
+    slots_ = std::make_unique<Slot[]>(size);
+    for (size_t i = 0; i < size; ++i) slots_[i].sequence.store(i, std::memory_order_relaxed);
+  }
+  MpscRingBuffer(const MpscRingBuffer&) = delete;
+  MpscRingBuffer& operator=(const MpscRingBuffer&) = delete;
+
+  size_t capacity() const { return mask_ + 1; }
+
+  // Any thread. Returns false if the ring is full.
+  bool TryPush(const T& value) {
+    size_t pos = tail_.load(std::memory_order_relaxed);
+    for (;;) {
+      Slot& slot = slots_[pos & mask_];
+      const size_t seq = slot.sequence.load(std::memory_order_acquire);
+      const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+      if (diff == 0) {
+        if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          slot.value = value;
+          slot.sequence.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;  // The consumer has not freed this slot yet.
+      } else {
+        pos = tail_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // Consumer thread only. Returns false if nothing is ready. A value whose
+  // producer has claimed a slot but not finished writing blocks the values
+  // behind it until it is published, so per-producer order is kept.
+  bool TryPop(T* value) {
+    Slot& slot = slots_[head_ & mask_];
+    if (slot.sequence.load(std::memory_order_acquire) != head_ + 1) return false;
+    *value = slot.value;
+    slot.sequence.store(head_ + mask_ + 1, std::memory_order_release);
+    ++head_;
+    return true;
+  }
+
+ private:
+  struct alignas(64) Slot {
+    std::atomic<size_t> sequence;
+    T value;
+  };
+
+  std::unique_ptr<Slot[]> slots_;
+  size_t mask_ = 0;
+  alignas(64) std::atomic<size_t> tail_{0};
+  alignas(64) size_t head_ = 0;
+};
+
+}  // namespace lvt
+
+#endif  // LARGE_VOLUME_TRADING_MPSC_RING_BUFFER_H_
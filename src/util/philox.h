@@ -0,0 +1,52 @@
+#ifndef LARGE_VOLUME_TRADING_PHILOX_H_
+#define LARGE_VOLUME_TRADING_PHILOX_H_
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <numbers>
+
+namespace lvt {
+
+// Philox4x32-10 counter-based generator (Salmon et al., "Parallel Random
+// Numbers: As Easy as 1, 2, 3", SC'11). Output is a pure function of
+// (counter, key), so any block of any stream can be produced directly,
+// by any thread, in any order, with identical results.
+class Philox4x32 {
+ public:
+  using Counter = std::array<uint32_t, 4>;
+  using Key = std::array<uint32_t, 2>;
+
+  static Counter Generate(Counter counter, Key key) {
+    for (int round = 0; round < 10; ++round) {
+      if (round > 0) {
+        key[0] += 0x9E3779B9u;
+        key[1] += 0xBB67AE85u;
+      }
+      const uint64_t p0 = uint64_t{0xD2511F53u} * counter[0];
+      const uint64_t p1 = uint64_t{0xCD9E8D57u} * counter[2];
+      counter = {static_cast<uint32_t>(p1 >> 32) ^ counter[1] ^ key[0], static_cast<uint32_t>(p1),
+                 static_cast<uint32_t>(p0 >> 32) ^ counter[3] ^ key[1], static_cast<uint32_t>(p0)};
+    }
+    return counter;
+  }
+};
+
+// Maps 32 random bits to a uniform double in the open interval (0, 1).
+inline double UniformOpen(uint32_t bits) { return (bits + 0.5) * 0x1p-32; }
+
+// Four standard normals from one Philox block (two Box-Muller pairs).
+inline std::array<double, 4> NormalBlock(const Philox4x32::Counter& bits) {
+  std::array<double, 4> z;
+  for (int i = 0; i < 4; i += 2) {
+    const double r = std::sqrt(-2.0 * std::log(UniformOpen(bits[i])));
+    const double theta = 2.0 * std::numbers::pi * UniformOpen(bits[i + 1]);
+    z[i] = r * std::cos(theta);
+    z[i + 1] = r * std::sin(theta);
+  }
+  return z;
+}
+
+}  // namespace lvt
+
+#endif  // LARGE_VOLUME_TRADING_PHILOX_H_
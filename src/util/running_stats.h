@@ -0,0 +1,56 @@
+#ifndef LARGE_VOLUME_TRADING_RUNNING_STATS_H_
+#define LARGE_VOLUME_TRADING_RUNNING_STATS_H_
+
+#include <cmath>
+#include <cstddef>
+
+namespace lvt {
+
+// Welford's online mean and variance: one pass, O(1) memory, and no
+// catastrophic cancellation from subtracting large sums of squares.
+class RunningStats {
+ public:
+  void Add(double x) {
+    ++count_;
+    const double delta = x - mean_;
+    mean_ += delta / count_;
+    m2_ += delta * (x - mean_);
+  }
+
+  size_t count() const { return count_; }
+  double mean() const { return mean_; }
+  // Population variance (divides by the count); 0 when empty.
+  double variance() const { return count_ > 0 ? m2_ / count_ : 0.0; }
+  double stddev() const { return std::sqrt(variance()); }
+
+ private:
+  size_t count_ = 0;
+  double mean_ = 0.0;
+  double m2_ = 0.0;
+};
+
+// Online covariance of (x, y) pairs with the same update scheme.
+class RunningCovariance {
+ public:
+  void Add(double x, double y) {
+    ++count_;
+    const double dx = x - mean_x_;
+    mean_x_ += dx / count_;
+    mean_y_ += (y - mean_y_) / count_;
+    co_moment_ += dx * (y - mean_y_);
+  }
+
+  size_t count() const { return count_; }
+  // Population covariance; 0 when empty.
+  double covariance() const { return count_ > 0 ? co_moment_ / count_ : 0.0; }
+
+ private:
+  size_t count_ = 0;
+  double mean_x_ = 0.0;
+  double mean_y_ = 0.0;
+  double co_moment_ = 0.0;
+};
+
+}  // namespace lvt
+
+#endif  // LARGE_VOLUME_TRADING_RUNNING_STATS_H_
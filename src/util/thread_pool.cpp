@@ -0,0 +1,118 @@
+#include "util/thread_pool.h"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+namespace lvt {
+
+namespace {
+
+// Identifies the pool and queue of the current worker thread, if any.
+thread_local const void* tls_pool = nullptr;
+thread_local size_t tls_queue = 0;
+
+}  // namespace
+
+ThreadPool::ThreadPool(size_t num_threads) : pending_(0), next_queue_(0), stopping_(false) {
+  if (num_threads == 0) num_threads = std::max(1u, std::thread::hardware_concurrency());
+  queues_.reserve(num_threads);
+  for (size_t i = 0; i < num_threads; ++i) queues_.push_back(std::make_unique<WorkerQueue>());
+  workers_.reserve(num_threads);
+  for (size_t i = 0; i < num_threads; ++i) workers_.emplace_back([this, i] { WorkerLoop(i); });
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(wake_mutex_);
+    stopping_ = true;
+  }
+  wake_cv_.notify_all();
+  for (auto& worker : workers_) worker.join();
+}
+
+void ThreadPool::Submit(std::function<void()> task) {
+  const size_t index = tls_pool == this ? tls_queue : next_queue_++ % queues_.size();
+  pending_++;
+  {
+    std::lock_guard<std::mutex> lock(queues_[index]->mutex);
+    queues_[index]->tasks.push_back(std::move(task));
+  }
+  // Taking the wake mutex orders this with a worker that is about to sleep.
+  { std::lock_guard<std::mutex> lock(wake_mutex_); }
+  wake_cv_.notify_one();
+}
+
+bool ThreadPool::TakeTask(size_t index, std::function<void()>* task) {
+  {
+    WorkerQueue& own = *queues_[index];
+    std::lock_guard<std::mutex> lock(own.mutex);
+    if (!own.tasks.empty()) {
+      *task = std::move(own.tasks.back());
+      own.tasks.pop_back();
+      return true;
+    }
+  }
+  for (size_t k = 1; k < queues_.size(); ++k) {
+    WorkerQueue& victim = *queues_[(index + k) % queues_.size()];
+    std::lock_guard<std::mutex> lock(victim.mutex);
+    if (!victim.tasks.empty()) {
+      *task = std::move(victim.tasks.front());
+      victim.tasks.pop_front();
+      return true;
+    }
+  }
+  return false;
+}
+
+void ThreadPool::WorkerLoop(size_t index) {
+  tls_pool = this;
+  tls_queue = index;
+  for (;;) {
+    std::function<void()> task;
+    if (TakeTask(index, &task)) {
+      pending_--;
+      task();
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(wake_mutex_);
+    if (pending_.load() > 0) {
+      // A task is being pushed right now; retry instead of sleeping.
+      lock.unlock();
+      std::this_thread::yield();
+      continue;
+    }
+    if (stopping_) return;
+    wake_cv_.wait(lock, [this] { return stopping_ || pending_.load() > 0; });
+  }
+}
+
+void ThreadPool::ParallelFor(size_t n, const std::function<void(size_t)>& fn) {
+  if (n == 0) return;
+  // Shared so helpers that only start after the loop finished can still
+  // look at it safely and exit.
+  struct State {
+    std::atomic<size_t> next{0};
+    std::atomic<size_t> done{0};
+    std::mutex mutex;
+    std::condition_variable cv;
+  };
+  auto state = std::make_shared<State>();
+  auto run = [state, n, &fn] {
+    size_t finished = 0;
+    for (size_t i = state->next++; i < n; i = state->next++) {
+      fn(i);
+      ++finished;
+    }
+    if (finished > 0 && state->done.fetch_add(finished) + finished == n) {
+      std::lock_guard<std::mutex> lock(state->mutex);
+      state->cv.notify_all();
+    }
+  };
+  const size_t helpers = std::min(n - 1, size());
+  for (size_t i = 0; i < helpers; ++i) Submit(run);
+  run();
+  std::unique_lock<std::mutex> lock(state->mutex);
+  state->cv.wait(lock, [&] { return state->done.load() == n; });
+}
+
+}  // namespace lvt
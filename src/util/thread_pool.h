@@ -0,0 +1,60 @@
+#ifndef LARGE_VOLUME_TRADING_THREAD_POOL_H_
+#define LARGE_VOLUME_TRADING_THREAD_POOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace lvt {
+
+// Fixed-size work-stealing pool. Every worker owns a task deque: tasks
+// submitted from a worker go to its own deque and are taken newest first,
+// tasks from other threads are spread round-robin, and an idle worker steals
+// the oldest task from another worker's deque.
+class ThreadPool {
+ public:
+  // num_threads == 0 uses std::thread::hardware_concurrency().
+  explicit ThreadPool(size_t num_threads = 0);
+  ~ThreadPool();
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  size_t size() const { return workers_.size(); }
+
+  // Queues `task` for execution on some worker. Safe to call from tasks.
+  void Submit(std::function<void()> task);
+
+  // Runs fn(i) for every i in [0, n) and returns when all calls finished.
+  // The calling thread takes part, so nested ParallelFor calls from inside
+  // pool tasks cannot deadlock.
+  void ParallelFor(size_t n, const std::function<void(size_t)>& fn);
+
+ private:
+  struct WorkerQueue {
+    std::mutex mutex;
+    std::deque<std::function<void()>> tasks;
+  };
+
+  void WorkerLoop(size_t index);
+  // Pops from the back of queue `index`, else steals from the front of another.
+  bool TakeTask(size_t index, std::function<void()>* task);
+
+  std::vector<std::unique_ptr<WorkerQueue>> queues_;
+  std::vector<std::thread> workers_;
+  // Queued tasks not yet taken; counted before the push so it never underflows.
+  std::atomic<size_t> pending_;
+  std::atomic<size_t> next_queue_;
+  std::mutex wake_mutex_;
+  std::condition_variable wake_cv_;
+  bool stopping_;
+};
+
+}  // namespace lvt
+
+#endif  // LARGE_VOLUME_TRADING_THREAD_POOL_H_
@@ -1,10 +1,28 @@
 #include "gtest/gtest.h"
 #include "strategy/almgren_kriss_model.h"
+#include "util/thread_pool.h"
+#include <chrono>
+#include <iostream>
 #include <numeric>
 #include <cmath>
+#include <vector>
 
 namespace lvt {
 
+namespace {
+
+// Direct evaluation of the trajectory: cosh weights normalized by their sum.
+std::vector<double> ReferenceSchedule(size_t n, double kappa, double volume) {
+  std::vector<double> out(n);
+  const double center = 0.5 * (n - 1);
+  double norm = 0.0;
+  for (size_t i = 0; i < n; ++i) norm += out[i] = std::cosh(kappa * (i - center));
+  for (auto& x : out) x = volume * x / norm;
+  return out;
+}
+
+}  // namespace
+
 // 1. Edge: No price data should yield empty schedule.
 TEST(AlmgrenKrissModelTest, EmptyPriceVector) {
   AlmgrenKrissModel model;
@@ -17,7 +35,8 @@ TEST(AlmgrenKrissModelTest, EmptyPriceVector) {
 // 2. Edge: Zero total volume should yield empty schedule.
 TEST(AlmgrenKrissModelTest, ZeroTotalVolume) {
   AlmgrenKrissModel model;
-  model.SetMarketData({1, 2}, 0.0);
+  std::vector<double> prices = {1, 2};
+  model.SetMarketData(prices, 0.0);
   model.SetParameters(1, 1, 1, 1);
   model.ComputeOptimalSchedule();
   EXPECT_TRUE(model.GetSchedule().empty());
@@ -26,7 +45,8 @@ TEST(AlmgrenKrissModelTest, ZeroTotalVolume) {
 // 3. One interval: all volume should go in first interval.
 TEST(AlmgrenKrissModelTest, SingleInterval) {
   AlmgrenKrissModel model;
-  model.SetMarketData({100}, 37);
+  std::vector<double> prices = {100};
+  model.SetMarketData(prices, 37);
   model.SetParameters(1, 1, 1, 1);
   model.ComputeOptimalSchedule();
   auto sched = model.GetSchedule();
@@ -37,7 +57,8 @@ TEST(AlmgrenKrissModelTest, SingleInterval) {
 // 4. Uniform with zero risk aversion (lambda = 0): even allocation.
 TEST(AlmgrenKrissModelTest, UniformWhenZeroLambda) {
   AlmgrenKrissModel model;
-  model.SetMarketData({1,1,1}, 30);
+  std::vector<double> prices = {1,1,1};
+  model.SetMarketData(prices, 30);
   model.SetParameters(1, 1, 1, 0);
   model.ComputeOptimalSchedule();
   const auto& sched = model.GetSchedule();
@@ -48,7 +69,8 @@ TEST(AlmgrenKrissModelTest, UniformWhenZeroLambda) {
 // 5. Uniform with zero eta (no temporary impact): uniform allocation.
 TEST(AlmgrenKrissModelTest, UniformWhenZeroEta) {
   AlmgrenKrissModel model;
-  model.SetMarketData({5, 6, 7, 8}, 20);
+  std::vector<double> prices = {5, 6, 7, 8};
+  model.SetMarketData(prices, 20);
   model.SetParameters(0, 1, 1, 1);
   model.ComputeOptimalSchedule();
   const auto& sched = model.GetSchedule();
@@ -59,7 +81,8 @@ TEST(AlmgrenKrissModelTest, UniformWhenZeroEta) {
 // 6. Risk-averse (large lambda): U-shaped schedule, central value lowest.
 TEST(AlmgrenKrissModelTest, UScheduleShapeLargeLambda) {
   AlmgrenKrissModel model;
-  model.SetMarketData({1,1,1,1,1}, 100);
+  std::vector<double> prices = {1,1,1,1,1};
+  model.SetMarketData(prices, 100);
   model.SetParameters(1, 1, 1, 1000);
   model.ComputeOptimalSchedule();
   const auto& sched = model.GetSchedule();
@@ -72,7 +95,8 @@ TEST(AlmgrenKrissModelTest, UScheduleShapeLargeLambda) {
 // 7. Risk-neutral (lambda -> 0): nearly flat schedule.
 TEST(AlmgrenKrissModelTest, FlatWhenRiskNeutral) {
   AlmgrenKrissModel model;
-  model.SetMarketData({1,1,1,1}, 40);
+  std::vector<double> prices = {1,1,1,1};
+  model.SetMarketData(prices, 40);
   model.SetParameters(1, 1, 1, 1e-10);
   model.ComputeOptimalSchedule();
   const auto& sched = model.GetSchedule();
@@ -93,7 +117,8 @@ TEST(AlmgrenKrissModelTest, ScheduleSumsToTotal) {
 // 9. Symmetry: schedule is symmetric for symmetric parameters.
 TEST(AlmgrenKrissModelTest, SymmetricSolution) {
   AlmgrenKrissModel model;
-  model.SetMarketData({1,1,1,1,1,1,1}, 70);
+  std::vector<double> prices = {1,1,1,1,1,1,1};
+  model.SetMarketData(prices, 70);
   model.SetParameters(1, 2, 3, 5);
   model.ComputeOptimalSchedule();
   const auto& sched = model.GetSchedule();
@@ -106,7 +131,8 @@ TEST(AlmgrenKrissModelTest, SymmetricSolution) {
 // 10. Schedule always non-negative and no NaN.
 TEST(AlmgrenKrissModelTest, NonNegativeAndFinite) {
   AlmgrenKrissModel model;
-  model.SetMarketData({1,2,3,4,5}, 50);
+  std::vector<double> prices = {1,2,3,4,5};
+  model.SetMarketData(prices, 50);
   model.SetParameters(7, 3, 2, 1);
   model.ComputeOptimalSchedule();
   for (auto x : model.GetSchedule()) {
@@ -115,4 +141,126 @@ TEST(AlmgrenKrissModelTest, NonNegativeAndFinite) {
   }
 }
 
+// 11. Multi-day: budget split by session length, each session solved on its own.
+TEST(AlmgrenKrissModelTest, MultiDaySplitsBudgetAcrossSessions) {
+  AlmgrenKrissModel model;
+  std::vector<double> day1(4, 1.0), day2(6, 1.0), day3(10, 1.0);
+  model.SetSessions({day1, day2, day3}, 200);
+  model.SetParameters(1, 1, 1, 5);
+  ThreadPool pool(3);
+  model.ComputeMultiDaySchedule(&pool);
+  const auto& sched = model.GetSchedule();
+  ASSERT_EQ(sched.size(), 20);
+  EXPECT_EQ(model.GetSessionOffsets(), (std::vector<size_t>{0, 4, 10}));
+  EXPECT_NEAR(std::accumulate(sched.begin(), sched.begin() + 4, 0.0), 40.0, 1e-8);
+  EXPECT_NEAR(std::accumulate(sched.begin() + 4, sched.begin() + 10, 0.0), 60.0, 1e-8);
+  EXPECT_NEAR(std::accumulate(sched.begin() + 10, sched.end(), 0.0), 100.0, 1e-8);
+
+  // Each session matches a stand-alone single-day solve of its budget.
+  AlmgrenKrissModel single;
+  single.SetMarketData(day3, 100);
+  single.SetParameters(1, 1, 1, 5);
+  single.ComputeOptimalSchedule();
+  for (size_t i = 0; i < day3.size(); ++i) EXPECT_NEAR(sched[10 + i], single.GetSchedule()[i], 1e-9);
+}
+
+// 12. Multi-day without a pool gives the same result serially.
+TEST(AlmgrenKrissModelTest, MultiDaySerialMatchesParallel) {
+  std::vector<double> day1(5, 1.0), day2(5, 1.0);
+  AlmgrenKrissModel serial, parallel;
+  for (auto* m : {&serial, &parallel}) {
+    m->SetSessions({day1, day2}, 50);
+    m->SetParameters(1, 1, 1, 2);
+  }
+  ThreadPool pool(2);
+  serial.ComputeMultiDaySchedule();
+  parallel.ComputeMultiDaySchedule(&pool);
+  EXPECT_EQ(serial.GetSchedule(), parallel.GetSchedule());
+}
+
+// 13. Closed-form kernel agrees with direct cosh evaluation.
+TEST(AlmgrenKrissModelTest, MatchesDirectCoshEvaluation) {
+  for (size_t n : {2, 3, 10, 391, 5000}) {
+    std::vector<double> prices(n, 1.0);
+    AlmgrenKrissModel model;
+    model.SetMarketData(prices, 1000);
+    model.SetParameters(1.0, 0.01, 0.5, 0.04);  // kappa = 0.1
+    model.ComputeOptimalSchedule();
+    auto expected = ReferenceSchedule(n, 0.1, 1000);
+    ASSERT_EQ(model.GetSchedule().size(), n);
+    for (size_t i = 0; i < n; ++i) {
+      EXPECT_NEAR(model.GetSchedule()[i], expected[i], 1e-12 * expected[i] + 1e-300) << "n=" << n << " i=" << i;
+    }
+  }
+}
+
+// 14. Very high risk aversion stays finite and front/back-loads the order
+// instead of falling back to a flat schedule.
+TEST(AlmgrenKrissModelTest, ExtremeKappaStaysStable) {
+  std::vector<double> prices(2001, 1.0);
+  AlmgrenKrissModel model;
+  model.SetMarketData(prices, 100);
+  model.SetParameters(1, 1, 1, 1e4);  // kappa * N / 2 ~ 1e5
+  model.ComputeOptimalSchedule();
+  const auto& sched = model.GetSchedule();
+  for (auto x : sched) {
+    EXPECT_GE(x, 0.0);
+    EXPECT_TRUE(std::isfinite(x));
+  }
+  EXPECT_NEAR(sched.front(), 50.0, 1e-9);
+  EXPECT_NEAR(sched.back(), 50.0, 1e-9);
+  EXPECT_NEAR(std::accumulate(sched.begin(), sched.end(), 0.0), 100.0, 1e-9);
+}
+
+// Speed of the kernel against direct cosh evaluation on 10^6 intervals.
+// Disabled by default; run with --gtest_also_run_disabled_tests.
+TEST(AlmgrenKrissModelTest, DISABLED_KernelSpeedMillionIntervals) {
+  const size_t n = 1000000;
+  const int reps = 20;
+  const double kappa = 1e-4;  // Keeps direct cosh evaluation finite.
+  std::vector<double> prices(n, 1.0);
+  AlmgrenKrissModel model;
+  model.SetMarketData(prices, 1e6);
+  model.SetParameters(1.0, 0.01, 1.0, kappa * kappa);
+
+  auto start = std::chrono::steady_clock::now();
+  for (int r = 0; r < reps; ++r) model.ComputeOptimalSchedule();
+  double kernel_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  std::vector<double> expected;
+  start = std::chrono::steady_clock::now();
+  for (int r = 0; r < reps; ++r) expected = ReferenceSchedule(n, kappa, 1e6);
+  double direct_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  for (size_t i = 0; i < n; i += 9973) EXPECT_NEAR(model.GetSchedule()[i], expected[i], 1e-10 * expected[i]);
+  std::cout << "[Log] 10^6 intervals: kernel " << kernel_s / reps * 1e3 << " ms, direct cosh "
+            << direct_s / reps * 1e3 << " ms (" << direct_s / kernel_s << "x)" << std::endl;
+}
+
+// 15. Cost and variance of a flat schedule match the closed-form sums.
+TEST(AlmgrenKrissModelTest, ExpectedCostAndVarianceOfFlatSchedule) {
+  AlmgrenKrissModel model;
+  std::vector<double> prices(4, 1.0);
+  model.SetMarketData(prices, 40);
+  model.SetParameters(2.0, 0.1, 0.5, 0.0);  // Flat: 10 per interval
+  model.ComputeOptimalSchedule();
+  // 0.5 * 0.1 * 40^2 + (2 - 0.05) * 4 * 10^2
+  EXPECT_NEAR(model.ExpectedCost(), 80.0 + 780.0, 1e-9);
+  // 0.25 * (30^2 + 20^2 + 10^2 + 0^2)
+  EXPECT_NEAR(model.CostVariance(), 350.0, 1e-9);
+}
+
+// 16. A flat schedule minimizes impact cost; risk aversion moves away from it.
+TEST(AlmgrenKrissModelTest, RiskAversionRaisesExpectedCost) {
+  std::vector<double> prices(30, 1.0);
+  AlmgrenKrissModel low, high;
+  low.SetMarketData(prices, 300);
+  high.SetMarketData(prices, 300);
+  low.SetParameters(1, 0.01, 0.5, 0.01);
+  high.SetParameters(1, 0.01, 0.5, 1.0);
+  low.ComputeOptimalSchedule();
+  high.ComputeOptimalSchedule();
+  EXPECT_LT(low.ExpectedCost(), high.ExpectedCost());
+}
+
 }  // namespace lvt
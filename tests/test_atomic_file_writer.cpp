@@ -0,0 +1,59 @@
+#include "gtest/gtest.h"
+#include "util/atomic_file_writer.h"
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+namespace lvt {
+
+namespace {
+
+std::string ReadFile(const std::filesystem::path& path) {
+  std::ifstream file(path, std::ios::binary);
+  std::stringstream ss;
+  ss << file.rdbuf();
+  return ss.str();
+}
+
+}  // namespace
+
+TEST(AtomicFileWriterTest, CommitReplacesTheFileInOnePiece) {
+  const auto path = std::filesystem::temp_directory_path() / "lvt_atomic_commit.bin";
+  {
+    std::ofstream old(path);
+    old << "old contents";
+  }
+  AtomicFileWriter writer;
+  ASSERT_TRUE(writer.Open(path.string()));
+  EXPECT_TRUE(writer.Write("new ", 4));
+  // The old file stays in place until the commit.
+  EXPECT_EQ(ReadFile(path), "old contents");
+  EXPECT_TRUE(writer.Write("contents", 8));
+  ASSERT_TRUE(writer.Commit());
+  EXPECT_EQ(ReadFile(path), "new contents");
+  EXPECT_FALSE(std::filesystem::exists(path.string() + ".tmp"));
+  std::filesystem::remove(path);
+}
+
+TEST(AtomicFileWriterTest, AbandonedFilesLeaveNothingBehind) {
+  const auto path = std::filesystem::temp_directory_path() / "lvt_atomic_abandon.bin";
+  std::filesystem::remove(path);
+  {
+    AtomicFileWriter writer;
+    ASSERT_TRUE(writer.Open(path.string()));
+    writer.Write("partial", 7);
+    EXPECT_TRUE(std::filesystem::exists(path.string() + ".tmp"));
+  }
+  EXPECT_FALSE(std::filesystem::exists(path.string() + ".tmp"));
+  EXPECT_FALSE(std::filesystem::exists(path));
+
+  AtomicFileWriter writer;
+  ASSERT_TRUE(writer.Open(path.string()));
+  writer.Abandon();
+  EXPECT_FALSE(writer.Commit());
+  EXPECT_FALSE(std::filesystem::exists(path));
+  EXPECT_FALSE(writer.Open("/nonexistent_dir/out.bin"));
+}
+
+}  // namespace lvt
@@ -0,0 +1,75 @@
+#include "gtest/gtest.h"
+#include "util/background_writer.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace lvt {
+
+TEST(BackgroundWriterTest, RunsTasksInSubmissionOrder) {
+  std::vector<int> order;
+  BackgroundWriter writer;
+  for (int i = 0; i < 100; ++i) {
+    writer.Submit([&order, i] {
+      order.push_back(i);
+      return true;
+    }, 1);
+  }
+  EXPECT_TRUE(writer.Drain());
+  ASSERT_EQ(order.size(), 100u);
+  for (int i = 0; i < 100; ++i) EXPECT_EQ(order[i], i);
+}
+
+TEST(BackgroundWriterTest, ReportsFailuresUntilDrained) {
+  BackgroundWriter writer;
+  writer.Submit([] { return true; }, 0);
+  writer.Submit([] { return false; }, 0);
+  writer.Submit([] { return true; }, 0);
+  EXPECT_FALSE(writer.Drain());
+  // The failure is reported once.
+  EXPECT_TRUE(writer.Drain());
+}
+
+TEST(BackgroundWriterTest, BoundsPendingBytes) {
+  BackgroundWriter writer(10);
+  std::atomic<int> pending{0};
+  std::atomic<int> max_pending{0};
+  std::vector<std::thread> producers;
+  for (int t = 0; t < 3; ++t) {
+    producers.emplace_back([&] {
+      for (int i = 0; i < 200; ++i) {
+        const int now = pending.fetch_add(1) + 1;
+        int seen = max_pending.load();
+        while (now > seen && !max_pending.compare_exchange_weak(seen, now)) {
+        }
+        writer.Submit([&pending] {
+          std::this_thread::yield();
+          pending.fetch_sub(1);
+          return true;
+        }, 4);
+      }
+    });
+  }
+  for (auto& producer : producers) producer.join();
+  EXPECT_TRUE(writer.Drain());
+  EXPECT_EQ(pending.load(), 0);
+  // At most two 4-byte tasks fit under the limit, plus one per producer
+  // that counted itself before blocking in Submit().
+  EXPECT_LE(max_pending.load(), 2 + 3);
+}
+
+TEST(BackgroundWriterTest, DestructorRunsQueuedTasks) {
+  std::atomic<int> ran{0};
+  {
+    BackgroundWriter writer;
+    for (int i = 0; i < 50; ++i) {
+      writer.Submit([&ran] {
+        ++ran;
+        return true;
+      }, 0);
+    }
+  }
+  EXPECT_EQ(ran.load(), 50);
+}
+
+}  // namespace lvt
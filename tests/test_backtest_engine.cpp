@@ -0,0 +1,150 @@
+#include "gtest/gtest.h"
+#include "engine/backtest_engine.h"
+#include "market/timestamp.h"
+#include <chrono>
+#include <iostream>
+#include <memory_resource>
+#include <vector>
+
+namespace lvt {
+
+namespace {
+
+class CountingResource : public std::pmr::memory_resource {
+ public:
+  size_t allocations = 0;
+
+ private:
+  void* do_allocate(size_t bytes, size_t alignment) override {
+    ++allocations;
+    return std::pmr::get_default_resource()->allocate(bytes, alignment);
+  }
+  void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+    std::pmr::get_default_resource()->deallocate(p, bytes, alignment);
+  }
+  bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+    return this == &other;
+  }
+};
+
+}  // namespace
+
+TEST(BacktestEngineTest, ReplaysScheduleAndFillsAtBarPrices) {
+  MarketDataColumns bars = {{0, 10.0, 100}, {60, 12.0, 100}, {120, 11.0, 200}};
+  std::vector<double> schedule = {5, 0, 15};
+  ScheduleStrategy strategy(schedule);
+  OrderManager orders;
+  BacktestEngine engine;
+  BacktestReport report;
+  ASSERT_TRUE(engine.Run(bars, &strategy, &orders, &report));
+
+  auto executions = orders.GetExecutions();
+  ASSERT_EQ(executions.size(), 2);  // The zero slice places no order.
+  EXPECT_EQ(executions[0].epoch_ns, 0);
+  EXPECT_DOUBLE_EQ(executions[1].quantity, 15);
+  EXPECT_DOUBLE_EQ(executions[1].price, 11.0);
+  EXPECT_EQ(report.bars, 3);
+  EXPECT_EQ(report.orders, 2);
+  EXPECT_DOUBLE_EQ(report.filled_volume, 20);
+  EXPECT_DOUBLE_EQ(report.average_price, (50.0 + 165.0) / 20.0);
+  EXPECT_DOUBLE_EQ(report.market_vwap, (1000.0 + 1200.0 + 2200.0) / 400.0);
+  EXPECT_NEAR(report.slippage_bps, (10.75 / 11.0 - 1.0) * 1e4, 1e-9);
+}
+
+TEST(BacktestEngineTest, IncrementalVWAPWithExactForecastTracksMarketVWAP) {
+  MarketDataColumns bars = {{0, 10.0, 100}, {60, 12.0, 300}, {120, 11.0, 600}};
+  IncrementalVWAP vwap;
+  vwap.Start(bars.volume(), 50);
+  IncrementalVWAPStrategy strategy(&vwap);
+  OrderManager orders;
+  BacktestReport report;
+  ASSERT_TRUE(BacktestEngine().Run(bars, &strategy, &orders, &report));
+  EXPECT_NEAR(report.filled_volume, 50, 1e-9);
+  EXPECT_NEAR(report.slippage_bps, 0.0, 1e-9);
+  EXPECT_NEAR(vwap.remaining_volume(), 0.0, 1e-9);
+}
+
+TEST(BacktestEngineTest, RejectsUnsortedBars) {
+  MarketDataColumns bars = {{60, 10.0, 100}, {0, 10.0, 100}};
+  std::vector<double> schedule = {1, 1};
+  ScheduleStrategy strategy(schedule);
+  OrderManager orders;
+  BacktestReport report;
+  EXPECT_FALSE(BacktestEngine().Run(bars, &strategy, &orders, &report));
+}
+
+TEST(BacktestEngineTest, AppliesImpactToFillPrices) {
+  MarketDataColumns bars = {{0, 10.0, 100}, {60, 10.0, 100}};
+  std::vector<double> schedule = {10, 20};
+  ScheduleStrategy strategy(schedule);
+  OrderManager orders;
+  BacktestReport report;
+  FillModel model;
+  model.eta = 0.01;
+  model.gamma = 0.001;
+  ASSERT_TRUE(BacktestEngine(model).Run(bars, &strategy, &orders, &report));
+
+  auto executions = orders.GetExecutions();
+  ASSERT_EQ(executions.size(), 2);
+  EXPECT_DOUBLE_EQ(executions[0].price, 10.0 + 0.01 * 10);
+  EXPECT_DOUBLE_EQ(executions[1].price, 10.0 + 0.001 * 10 + 0.01 * 20);
+  EXPECT_NEAR(report.impact_cost, 10 * 0.1 + 20 * 0.21, 1e-12);
+  EXPECT_GT(report.slippage_bps, 0.0);
+}
+
+TEST(BacktestEngineTest, ParticipationCapIsReplannedByIncrementalVWAP) {
+  MarketDataColumns bars = {{0, 10.0, 100}, {60, 10.0, 100}, {120, 10.0, 100}};
+  IncrementalVWAP vwap;
+  vwap.Start(bars.volume(), 90);
+  IncrementalVWAPStrategy strategy(&vwap);
+  OrderManager orders;
+  BacktestReport report;
+  FillModel model;
+  model.max_participation = 0.2;
+  ASSERT_TRUE(BacktestEngine(model).Run(bars, &strategy, &orders, &report));
+
+  // Orders of 30, 35 and 50 are each cut to 20; the strategy re-plans the
+  // shortfall over the remaining bars.
+  EXPECT_DOUBLE_EQ(report.filled_volume, 60);
+  EXPECT_DOUBLE_EQ(report.ordered_volume, 115);
+  EXPECT_DOUBLE_EQ(report.unfilled_volume, 55);
+  EXPECT_DOUBLE_EQ(vwap.executed_volume(), 60);
+  EXPECT_DOUBLE_EQ(vwap.remaining_volume(), 30);
+}
+
+TEST(BacktestEngineTest, ReplayAllocatesOnlyTheReservedLog) {
+  MarketDataColumns bars;
+  for (int i = 0; i < 1000; ++i) bars.Append(i * kNanosPerMinute, 100.0 + i % 7, 10.0);
+  std::vector<double> schedule(bars.size(), 1.0);
+  ScheduleStrategy strategy(schedule);
+  CountingResource counting;
+  OrderManager orders(&counting);
+  BacktestReport report;
+  ASSERT_TRUE(BacktestEngine().Run(bars, &strategy, &orders, &report));
+  EXPECT_EQ(report.orders, 1000);
+  EXPECT_EQ(counting.allocations, 1);
+}
+
+// Replay speed for a year of minute bars (365 days x 1440 minutes).
+// Disabled by default; run with --gtest_also_run_disabled_tests.
+TEST(BacktestEngineTest, DISABLED_YearOfMinuteBars) {
+  MarketDataColumns bars;
+  const size_t n = 365 * 1440;
+  bars.Reserve(n);
+  for (size_t i = 0; i < n; ++i) {
+    bars.Append(static_cast<int64_t>(i) * kNanosPerMinute, 100.0 + (i % 100) * 0.01, 1000.0 + i % 500);
+  }
+  IncrementalVWAP vwap;
+  vwap.Start(bars.volume(), 1e6);
+  IncrementalVWAPStrategy strategy(&vwap);
+  OrderManager orders;
+  BacktestReport report;
+  auto start = std::chrono::steady_clock::now();
+  ASSERT_TRUE(BacktestEngine().Run(bars, &strategy, &orders, &report));
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  EXPECT_EQ(report.orders, n);
+  EXPECT_LT(seconds, 1.0);
+  std::cout << "[Log] Replayed " << n << " bars in " << seconds * 1e3 << " ms" << std::endl;
+}
+
+}  // namespace lvt
@@ -0,0 +1,171 @@
+#include "gtest/gtest.h"
+#include "engine/batch_runner.h"
+#include "util/background_writer.h"
+#include "util/thread_pool.h"
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace lvt {
+
+namespace {
+
+std::string ReadFile(const std::filesystem::path& path) {
+  std::ifstream file(path);
+  std::stringstream ss;
+  ss << file.rdbuf();
+  return ss.str();
+}
+
+}  // namespace
+
+TEST(BatchRunnerTest, LoadsManifestWithDefaultsAndOverrides) {
+  const auto dir = std::filesystem::temp_directory_path() / "lvt_batch_manifest";
+  std::filesystem::create_directories(dir);
+  const auto manifest = dir / "jobs.csv";
+  {
+    std::ofstream file(manifest);
+    file << "input,strategy,total_volume\n"
+         << "# comment\n"
+         << "data/AAPL.csv,VWAP,1000\n"
+         << "\n"
+         << "data/MSFT.csv,AlmgrenKriss,500,lambda=2,symbol=MSFT.O,output=x/m.csv\n";
+  }
+  std::vector<BatchJob> jobs;
+  ASSERT_TRUE(LoadBatchManifest(manifest.string(), "out", &jobs));
+  ASSERT_EQ(jobs.size(), 2);
+  EXPECT_EQ(jobs[0].symbol, "AAPL");
+  EXPECT_EQ(jobs[0].output, (std::filesystem::path("out") / "AAPL.csv").string());
+  EXPECT_DOUBLE_EQ(jobs[0].total_volume, 1000);
+  EXPECT_EQ(jobs[1].symbol, "MSFT.O");
+  EXPECT_EQ(jobs[1].output, "x/m.csv");
+  EXPECT_DOUBLE_EQ(jobs[1].params.at("lambda"), 2);
+  {
+    std::ofstream file(manifest);
+    file << "data/AAPL.csv,VWAP,lots\n";
+  }
+  EXPECT_FALSE(LoadBatchManifest(manifest.string(), "out", &jobs));
+  std::filesystem::remove_all(dir);
+}
+
+TEST(BatchRunnerTest, RunsJobsConcurrentlyAndWritesOneOutputEach) {
+  const auto dir = std::filesystem::temp_directory_path() / "lvt_batch_run";
+  std::filesystem::remove_all(dir);
+  std::filesystem::create_directories(dir);
+  std::vector<BatchJob> jobs;
+  const char* strategies[] = {"VWAP", "OptimalSpeed", "AlmgrenKriss"};
+  for (int s = 0; s < 6; ++s) {
+    const auto input = dir / ("SYM" + std::to_string(s) + ".csv");
+    {
+      std::ofstream file(input);
+      file << "timestamp,price,volume\n";
+      for (int i = 0; i < 4; ++i) file << "2025-11-24 14:3" << i << ":00+00:00,100," << (i + 1) * 10 << "\n";
+    }
+    BatchJob job;
+    job.symbol = "SYM" + std::to_string(s);
+    job.input = input.string();
+    job.strategy = strategies[s % 3];
+    job.total_volume = 100;
+    job.output = (dir / "out" / (job.symbol + ".csv")).string();
+    jobs.push_back(job);
+  }
+  BatchJob missing = jobs[0];
+  missing.symbol = "MISSING";
+  missing.input = (dir / "missing.csv").string();
+  jobs.push_back(missing);
+
+  ThreadPool pool(3);
+  BatchRunner runner;
+  EXPECT_FALSE(runner.Run(jobs, &pool));
+  const auto& results = runner.GetResults();
+  ASSERT_EQ(results.size(), jobs.size());
+  for (size_t i = 0; i + 1 < jobs.size(); ++i) {
+    EXPECT_TRUE(results[i].ok) << jobs[i].symbol;
+    EXPECT_EQ(results[i].bars, 4);
+    EXPECT_EQ(results[i].intervals, 4);
+  }
+  EXPECT_FALSE(results.back().ok);
+  EXPECT_EQ(ReadFile(dir / "out" / "SYM0.csv"),
+            "timestamp,trade_volume\n"
+            "2025-11-24 14:30:00+00:00,10\n"
+            "2025-11-24 14:31:00+00:00,20\n"
+            "2025-11-24 14:32:00+00:00,30\n"
+            "2025-11-24 14:33:00+00:00,40\n");
+  EXPECT_EQ(ReadFile(dir / "out" / "SYM1.csv").substr(0, 22), "interval,trade_volume\n");
+
+  std::ostringstream summary;
+  runner.WriteTimingSummary(summary);
+  EXPECT_NE(summary.str().find("SYM5,ok,4,4,"), std::string::npos);
+  EXPECT_NE(summary.str().find("MISSING,failed"), std::string::npos);
+  EXPECT_NE(summary.str().find("# 7 jobs, 1 failed"), std::string::npos);
+  std::filesystem::remove_all(dir);
+}
+
+TEST(BatchRunnerTest, RealizesSchedulesWithTheJobsFillModel) {
+  const auto dir = std::filesystem::temp_directory_path() / "lvt_batch_fills";
+  std::filesystem::remove_all(dir);
+  std::filesystem::create_directories(dir);
+  BatchJob job;
+  job.symbol = "SYM";
+  job.input = (dir / "SYM.csv").string();
+  {
+    std::ofstream file(job.input);
+    file << "timestamp,price,volume\n";
+    for (int i = 0; i < 4; ++i) file << "2025-11-24 14:3" << i << ":00+00:00,100," << (i + 1) * 10 << "\n";
+  }
+  job.strategy = "VWAP";
+  job.total_volume = 100;
+  job.output = (dir / "SYM.csv.out").string();
+  BatchJobResult result;
+  ASSERT_TRUE(BatchRunner::RunJob(job, LoadMode::kStream, &result));
+  EXPECT_DOUBLE_EQ(result.fills.filled_volume, 100);
+  EXPECT_DOUBLE_EQ(result.fills.impact_cost, 0);
+
+  // The VWAP slices are 10, 20, 30, 40; half of each bar's volume fills.
+  job.params = {{"max_participation", 0.5}, {"impact_eta", 0.01}};
+  ASSERT_TRUE(BatchRunner::RunJob(job, LoadMode::kStream, &result));
+  EXPECT_DOUBLE_EQ(result.fills.filled_volume, 50);
+  EXPECT_NEAR(result.fills.impact_cost, 0.01 * (25 + 100 + 225 + 400), 1e-9);
+  std::filesystem::remove_all(dir);
+}
+
+TEST(BatchRunnerTest, WritesBinaryOutputInTheBackground) {
+  const auto dir = std::filesystem::temp_directory_path() / "lvt_batch_async";
+  std::filesystem::remove_all(dir);
+  std::filesystem::create_directories(dir);
+  const auto input = dir / "SYM.csv";
+  {
+    std::ofstream file(input);
+    file << "timestamp,price,volume\n";
+    for (int i = 0; i < 4; ++i) file << "2025-11-24 14:3" << i << ":00+00:00,100," << (i + 1) * 10 << "\n";
+  }
+  const auto manifest = dir / "manifest.csv";
+  {
+    std::ofstream file(manifest);
+    file << input.string() << ",VWAP,100\n" << input.string() << ",OptimalSpeed,100,symbol=SPEED\n";
+  }
+  std::vector<BatchJob> jobs;
+  ASSERT_TRUE(LoadBatchManifest(manifest.string(), (dir / "out").string(), &jobs,
+                                OutputExtension(OutputFormat::kBinary)));
+  ASSERT_EQ(jobs.size(), 2u);
+  EXPECT_EQ(jobs[0].output, (dir / "out" / "SYM.lvts").string());
+
+  ThreadPool pool(2);
+  BackgroundWriter background;
+  BatchRunner runner(LoadMode::kStream, OutputFormat::kBinary, &background);
+  EXPECT_TRUE(runner.Run(jobs, &pool));
+  std::vector<ScheduleRecord> rows;
+  OutputKind kind;
+  ASSERT_TRUE(ReadBinarySchedule(jobs[0].output, &kind, &rows));
+  EXPECT_EQ(kind, OutputKind::kTimestampSchedule);
+  ASSERT_EQ(rows.size(), 4u);
+  EXPECT_EQ(rows[3].trade_volume, 40.0);
+  ASSERT_TRUE(ReadBinarySchedule(jobs[1].output, &kind, &rows));
+  EXPECT_EQ(kind, OutputKind::kIntervalSchedule);
+  EXPECT_EQ(rows.size(), 4u);
+  std::filesystem::remove_all(dir);
+}
+
+}  // namespace lvt
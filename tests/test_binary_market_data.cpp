@@ -0,0 +1,163 @@
+#include "gtest/gtest.h"
+#include "market/binary_market_data.h"
+#include "market/market_simulator.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+
+namespace lvt {
+
+namespace {
+
+std::filesystem::path TempPath(const char* name) {
+  return std::filesystem::temp_directory_path() / name;
+}
+
+void WriteCsv(const std::filesystem::path& path, double last_price) {
+  std::ofstream file(path);
+  file << "timestamp,price,volume\n"
+       << "2025-11-24 14:30:00+00:00,273.17,2295845\n"
+       << "2025-11-24 14:31:00+00:00," << last_price << ",261737\n";
+}
+
+}  // namespace
+
+TEST(BinaryMarketDataTest, RoundTripsColumnsAndHeader) {
+  const auto path = TempPath("lvt_binary_round_trip.lvtc");
+  MarketDataColumns data = {{1, 10.5, 100}, {2, 11.5, 200}, {3, 12.5, 300}};
+  SourceFileInfo source;
+  source.size = 42;
+  source.mtime_ns = 7;
+  source.hash = HashBytes("abc");
+  ASSERT_TRUE(WriteBinaryMarketData(path.string(), data, source));
+  EXPECT_TRUE(IsBinaryMarketDataFile(path.string()));
+
+  MarketDataColumns loaded;
+  BinaryMarketDataHeader header;
+  ASSERT_TRUE(ReadBinaryMarketData(path.string(), &loaded, &header));
+  std::filesystem::remove(path);
+  // The columns point into the mapping, which stays valid after the unlink.
+  EXPECT_TRUE(loaded.borrowed());
+  ASSERT_EQ(loaded.size(), 3);
+  EXPECT_EQ(loaded.epoch_ns()[2], 3);
+  EXPECT_DOUBLE_EQ(loaded.price()[1], 11.5);
+  EXPECT_DOUBLE_EQ(loaded.volume()[0], 100);
+  EXPECT_EQ(header.row_count, 3);
+  EXPECT_EQ(header.source_size, 42);
+  EXPECT_EQ(header.source_mtime_ns, 7);
+  EXPECT_EQ(header.source_hash, HashBytes("abc"));
+}
+
+TEST(BinaryMarketDataTest, RejectsTruncatedFile) {
+  const auto path = TempPath("lvt_binary_truncated.lvtc");
+  ASSERT_TRUE(WriteBinaryMarketData(path.string(), {{1, 1, 1}, {2, 2, 2}}, {}));
+  std::filesystem::resize_file(path, std::filesystem::file_size(path) - 8);
+  MarketDataColumns loaded;
+  EXPECT_FALSE(ReadBinaryMarketData(path.string(), &loaded));
+  std::filesystem::remove(path);
+}
+
+TEST(BinaryMarketDataTest, RejectsRowCountThatWrapsTheSizeCheck) {
+  const auto path = TempPath("lvt_binary_huge_row_count.lvtc");
+  ASSERT_TRUE(WriteBinaryMarketData(path.string(), MarketDataColumns(), {}));
+  ASSERT_EQ(std::filesystem::file_size(path), sizeof(BinaryMarketDataHeader));
+  {
+    // 2^62 rows of 24 bytes wrap to 0 in 64 bits, matching the empty file.
+    std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+    const uint64_t row_count = uint64_t{1} << 62;
+    file.seekp(offsetof(BinaryMarketDataHeader, row_count));
+    file.write(reinterpret_cast<const char*>(&row_count), sizeof(row_count));
+  }
+  BinaryMarketDataHeader header;
+  EXPECT_FALSE(ReadBinaryMarketDataHeader(path.string(), &header));
+  MarketDataColumns loaded;
+  EXPECT_FALSE(ReadBinaryMarketData(path.string(), &loaded));
+  std::filesystem::remove(path);
+}
+
+TEST(BinaryMarketDataTest, CsvIsNotBinary) {
+  const auto path = TempPath("lvt_binary_plain.csv");
+  WriteCsv(path, 274.0);
+  EXPECT_FALSE(IsBinaryMarketDataFile(path.string()));
+  std::filesystem::remove(path);
+}
+
+TEST(BinaryMarketDataTest, SimulatorLoadsBinaryInputDirectly) {
+  const auto path = TempPath("lvt_binary_input.lvtc");
+  ASSERT_TRUE(WriteBinaryMarketData(path.string(), {{1, 5, 50}, {2, 6, 60}}, {}));
+  MarketSimulator sim(path.string());
+  ASSERT_TRUE(sim.Load());
+  std::filesystem::remove(path);
+  ASSERT_EQ(sim.GetMarketData().size(), 2);
+  EXPECT_DOUBLE_EQ(sim.GetMarketData().price()[1], 6);
+}
+
+TEST(BinaryMarketDataTest, CacheIsBuiltReusedAndRebuilt) {
+  const auto csv = TempPath("lvt_binary_cache.csv");
+  const std::string cache = BinaryCachePath(csv.string());
+  std::filesystem::remove(cache);
+  WriteCsv(csv, 274.0);
+
+  MarketSimulator first(csv.string());
+  ASSERT_TRUE(first.Load(LoadMode::kCached));
+  ASSERT_TRUE(std::filesystem::exists(cache));
+  EXPECT_EQ(first.GetLoadStats().lines_skipped, 1);  // Parsed the CSV
+
+  MarketSimulator second(csv.string());
+  ASSERT_TRUE(second.Load(LoadMode::kCached));
+  EXPECT_EQ(second.GetLoadStats().lines_skipped, 0);  // Served from cache
+  EXPECT_DOUBLE_EQ(second.GetMarketData().price()[1], 274.0);
+
+  // Same size, new content and mtime: the cache must be rebuilt.
+  WriteCsv(csv, 275.0);
+  std::filesystem::last_write_time(csv, std::filesystem::last_write_time(csv) + std::chrono::seconds(5));
+  MarketSimulator third(csv.string());
+  ASSERT_TRUE(third.Load(LoadMode::kCached));
+  EXPECT_DOUBLE_EQ(third.GetMarketData().price()[1], 275.0);
+
+  BinaryMarketDataHeader header;
+  ASSERT_TRUE(ReadBinaryMarketDataHeader(cache, &header));
+  SourceFileInfo source;
+  ASSERT_TRUE(StatSourceFile(csv.string(), &source));
+  EXPECT_EQ(header.source_mtime_ns, source.mtime_ns);
+  std::filesystem::remove(csv);
+  std::filesystem::remove(cache);
+}
+
+TEST(BinaryMarketDataTest, StreamingWriterMatchesOneShotWrite) {
+  const auto path = TempPath("lvt_binary_streamed.lvtc");
+  MarketDataColumns data;
+  for (int i = 0; i < 10; ++i) data.Append(i, 100.0 + i, 10.0 * i);
+  BinaryMarketDataWriter writer;
+  ASSERT_TRUE(writer.Open(path.string(), data.size()));
+  MarketDataView view = data;
+  ASSERT_TRUE(writer.Append(view.subview(0, 4)));
+  ASSERT_TRUE(writer.Append(view.subview(4, 6)));
+  EXPECT_FALSE(writer.Append(view.subview(0, 1)));  // Beyond the row count.
+  ASSERT_TRUE(writer.Finish());
+
+  MarketDataColumns loaded;
+  ASSERT_TRUE(ReadBinaryMarketData(path.string(), &loaded));
+  std::filesystem::remove(path);
+  ASSERT_EQ(loaded.size(), 10);
+  for (size_t i = 0; i < 10; ++i) {
+    EXPECT_EQ(loaded.epoch_ns()[i], data.epoch_ns()[i]);
+    EXPECT_EQ(loaded.price()[i], data.price()[i]);
+    EXPECT_EQ(loaded.volume()[i], data.volume()[i]);
+  }
+}
+
+TEST(BinaryMarketDataTest, StreamingWriterRejectsShortFile) {
+  const auto path = TempPath("lvt_binary_short.lvtc");
+  BinaryMarketDataWriter writer;
+  ASSERT_TRUE(writer.Open(path.string(), 5));
+  MarketDataColumns data = {{0, 1, 1}};
+  ASSERT_TRUE(writer.Append(data));
+  EXPECT_FALSE(writer.Finish());
+  EXPECT_FALSE(std::filesystem::exists(path));
+  EXPECT_FALSE(std::filesystem::exists(path.string() + ".tmp"));
+}
+
+}  // namespace lvt
@@ -0,0 +1,169 @@
+#include "gtest/gtest.h"
+#include "market/csv_parser.h"
+#include "market/timestamp.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace lvt {
+
+// Test 1: Header, blank lines and valid rows.
+// Purpose: Header and whitespace-only lines are skipped and counted.
+TEST(MarketDataCsvParserTest, SkipsHeaderAndBlankLines) {
+  MarketDataCsvParser parser;
+  MarketDataColumns out;
+  parser.Parse("timestamp,price,volume\n\n   \n"
+               "2025-11-24 14:30:00+00:00,273.17,2295845\n"
+               "2025-11-24 14:31:00+00:00,273.98,261737\n", &out);
+  ASSERT_EQ(out.size(), 2);
+  EXPECT_EQ(out.Timestamp(0), "2025-11-24 14:30:00+00:00");
+  EXPECT_DOUBLE_EQ(out.price()[0], 273.17);
+  EXPECT_DOUBLE_EQ(out.volume()[0], 2295845);
+  EXPECT_DOUBLE_EQ(out.price()[1], 273.98);
+  EXPECT_EQ(out.epoch_ns()[1] - out.epoch_ns()[0], kNanosPerMinute);
+  EXPECT_EQ(parser.stats().lines_processed, 2);
+  EXPECT_EQ(parser.stats().lines_skipped, 3);
+}
+
+// Test 2: Malformed rows.
+// Purpose: Missing fields, bad timestamps and non-numeric values are skipped, not fatal.
+TEST(MarketDataCsvParserTest, SkipsMalformedRows) {
+  MarketDataCsvParser parser;
+  MarketDataColumns out;
+  parser.Parse("2025-01-01 09:30:00,1.5\n"
+               "2025-01-01 09:31:00,abc,10\n"
+               "2025-01-01 09:32:00,2.5,\n"
+               "no commas at all\n"
+               "2025-01-01 09:33:00,,7\n"
+               "t4,3.5,12\n"
+               "2025-01-01 09:35:00,3.5,12\n", &out);
+  ASSERT_EQ(out.size(), 1);
+  EXPECT_EQ(out.Timestamp(0), "2025-01-01 09:35:00+00:00");
+  EXPECT_EQ(parser.stats().lines_processed, 1);
+  EXPECT_EQ(parser.stats().lines_skipped, 6);
+}
+
+// Test 3: Number formats accepted by std::stod.
+// Purpose: Leading spaces, '+', exponents, CRLF endings and extra columns all parse.
+TEST(MarketDataCsvParserTest, AcceptsStodCompatibleNumbers) {
+  MarketDataCsvParser parser;
+  MarketDataColumns out;
+  parser.Parse("2025-01-01,1.25,+3e2\r\n"
+               "2025-01-01,-4,5,extra\n"
+               "2025-01-01, 7,8", &out);
+  ASSERT_EQ(out.size(), 3);
+  EXPECT_DOUBLE_EQ(out.price()[0], 1.25);
+  EXPECT_DOUBLE_EQ(out.volume()[0], 300.0);
+  EXPECT_DOUBLE_EQ(out.price()[1], -4.0);
+  EXPECT_DOUBLE_EQ(out.volume()[1], 5.0);
+  EXPECT_DOUBLE_EQ(out.volume()[2], 8.0);  // Last line without '\n'
+}
+
+// Test 4: Timestamp offsets are normalized to UTC.
+// Purpose: The same instant written with different offsets maps to one epoch value.
+TEST(MarketDataCsvParserTest, NormalizesTimestampOffsets) {
+  MarketDataCsvParser parser;
+  MarketDataColumns out;
+  parser.Parse("2025-11-24 14:30:00+00:00,1,2\n"
+               "2025-11-24T09:30:00-05:00,1,2\n"
+               "2025-11-24 14:30:00Z,1,2\n", &out);
+  ASSERT_EQ(out.size(), 3);
+  EXPECT_EQ(out.epoch_ns()[0], out.epoch_ns()[1]);
+  EXPECT_EQ(out.epoch_ns()[0], out.epoch_ns()[2]);
+}
+
+// Test 5: Chunked input keeps parser state.
+// Purpose: Header flag and counters survive across Parse() calls.
+TEST(MarketDataCsvParserTest, ChunkedInputMatchesWholeBuffer) {
+  MarketDataCsvParser parser;
+  MarketDataColumns out;
+  parser.Parse("timestamp,price,volume\n2025-01-01 09:30:00,1,2\n", &out);
+  parser.Parse("\n2025-01-01 09:31:00,3,4\n", &out);
+  ASSERT_EQ(out.size(), 2);
+  EXPECT_DOUBLE_EQ(out.price()[1], 3.0);
+  EXPECT_EQ(parser.stats().lines_processed, 2);
+  EXPECT_EQ(parser.stats().lines_skipped, 2);
+  parser.Reset();
+  EXPECT_EQ(parser.stats().lines_processed, 0);
+}
+
+// Test 6: Bounded parsing for streaming.
+// Purpose: ParseLines stops at max_rows and leaves incomplete lines unconsumed.
+TEST(MarketDataCsvParserTest, ParseLinesStopsAtRowLimitAndPartialLine) {
+  MarketDataCsvParser parser;
+  MarketDataColumns out;
+  std::string_view text = "2025-01-01,1,1\n2025-01-01,2,2\n2025-01-01,3,3\n2025-01-01,4,4";
+  size_t consumed = parser.ParseLines(text, 2, &out);
+  EXPECT_EQ(out.size(), 2);
+  EXPECT_EQ(text.substr(consumed), "2025-01-01,3,3\n2025-01-01,4,4");
+  consumed += parser.ParseLines(text.substr(consumed), 10, &out);
+  EXPECT_EQ(out.size(), 3);
+  EXPECT_EQ(text.substr(consumed), "2025-01-01,4,4");
+  parser.ParseFinalLine(text.substr(consumed), &out);
+  ASSERT_EQ(out.size(), 4);
+  EXPECT_DOUBLE_EQ(out.price()[3], 4.0);
+}
+
+// Throughput check over a multi-GB synthetic file. Disabled by default;
+// run with --gtest_also_run_disabled_tests. Size is set in MB through
+// LVT_CSV_THROUGHPUT_MB (default 2048).
+TEST(MarketDataCsvParserTest, DISABLED_ThroughputMultiGigabyteFile) {
+  size_t target_mb = 2048;
+  if (const char* env = std::getenv("LVT_CSV_THROUGHPUT_MB")) target_mb = std::strtoull(env, nullptr, 10);
+  const size_t target_bytes = target_mb << 20;
+  const auto path = std::filesystem::temp_directory_path() / "lvt_csv_throughput.csv";
+  size_t expected_rows = 0;
+  {
+    std::ofstream file(path, std::ios::binary);
+    ASSERT_TRUE(file.is_open());
+    file << "timestamp,price,volume\n";
+    std::string block;
+    size_t written = 0;
+    while (written < target_bytes) {
+      block.clear();
+      for (int i = 0; i < 10000; ++i, ++expected_rows) {
+        block += "2025-11-24 14:30:00+00:00,";
+        block += std::to_string(273.0 + (expected_rows % 1000) * 0.01);
+        block += ',';
+        block += std::to_string(1000 + expected_rows % 5000);
+        block += '\n';
+      }
+      file.write(block.data(), block.size());
+      written += block.size();
+    }
+  }
+
+  const size_t file_bytes = std::filesystem::file_size(path);
+  std::ifstream file(path, std::ios::binary);
+  MarketDataCsvParser parser;
+  MarketDataColumns rows;
+  std::string chunk;
+  std::string carry;
+  const size_t kChunkBytes = 64 << 20;
+  auto start = std::chrono::steady_clock::now();
+  while (file) {
+    chunk.resize(kChunkBytes);
+    file.read(chunk.data(), kChunkBytes);
+    chunk.resize(file.gcount());
+    chunk.insert(0, carry);
+    if (chunk.empty()) break;
+    size_t last_newline = chunk.rfind('\n');
+    if (last_newline == std::string::npos || !file) last_newline = chunk.size() - 1;
+    carry.assign(chunk, last_newline + 1);
+    rows.Clear();
+    parser.Parse(std::string_view(chunk.data(), last_newline + 1), &rows);
+  }
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  std::filesystem::remove(path);
+
+  EXPECT_EQ(parser.stats().lines_processed, expected_rows);
+  std::cout << "[Log] Parsed " << (file_bytes >> 20) << " MB in " << seconds << " s ("
+            << (file_bytes >> 20) / seconds << " MB/s)" << std::endl;
+}
+
+}  // namespace lvt
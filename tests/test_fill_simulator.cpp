@@ -0,0 +1,100 @@
+#include "gtest/gtest.h"
+#include "order/fill_simulator.h"
+#include "market/timestamp.h"
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+namespace lvt {
+
+TEST(FillSimulatorTest, DefaultModelFillsInFullAtBarPrice) {
+  MarketDataColumns bars = {{0, 10.0, 100}, {60, 12.0, 0}};
+  std::vector<double> schedule = {5, 500};
+  std::vector<double> fills(2), prices(2);
+  FillSimulator().Simulate(bars, schedule, fills, prices);
+  EXPECT_DOUBLE_EQ(fills[0], 5);
+  EXPECT_DOUBLE_EQ(fills[1], 500);  // No cap, even on a bar without volume.
+  EXPECT_DOUBLE_EQ(prices[0], 10.0);
+  EXPECT_DOUBLE_EQ(prices[1], 12.0);
+}
+
+TEST(FillSimulatorTest, AppliesCapAndLinearImpact) {
+  MarketDataColumns bars = {{0, 10.0, 100}, {60, 11.0, 50}, {120, 12.0, 400}};
+  std::vector<double> schedule = {30, 30, -5};
+  std::vector<double> fills(3), prices(3);
+  FillModel model;
+  model.eta = 0.01;
+  model.gamma = 0.002;
+  model.max_participation = 0.2;
+  FillSimulator(model).Simulate(bars, schedule, fills, prices);
+  EXPECT_DOUBLE_EQ(fills[0], 20);
+  EXPECT_DOUBLE_EQ(fills[1], 10);
+  EXPECT_DOUBLE_EQ(fills[2], 0);  // Negative orders place nothing.
+  EXPECT_DOUBLE_EQ(prices[0], 10.0 + 0.01 * 20);
+  EXPECT_DOUBLE_EQ(prices[1], 11.0 + 0.002 * 20 + 0.01 * 10);
+  EXPECT_DOUBLE_EQ(prices[2], 12.0 + 0.002 * 30);
+}
+
+TEST(FillSimulatorTest, SellsPushPricesDown) {
+  MarketDataColumns bars = {{0, 10.0, 100}, {60, 10.0, 100}};
+  std::vector<double> schedule = {10, 10};
+  std::vector<double> fills(2), prices(2);
+  FillModel model;
+  model.eta = 0.01;
+  model.gamma = 0.001;
+  model.sell = true;
+  FillSimulator(model).Simulate(bars, schedule, fills, prices);
+  EXPECT_DOUBLE_EQ(prices[0], 10.0 - 0.1);
+  EXPECT_DOUBLE_EQ(prices[1], 10.0 - 0.01 - 0.1);
+}
+
+TEST(FillSimulatorTest, PerBarFillsMatchWholeSchedule) {
+  MarketDataColumns bars;
+  std::vector<double> schedule;
+  for (int i = 0; i < 257; ++i) {
+    bars.Append(i * kNanosPerMinute, 100.0 + i % 11, 50.0 + i % 13 * 10);
+    schedule.push_back(i % 5 * 7.0);
+  }
+  FillModel model;
+  model.eta = 0.003;
+  model.gamma = 0.0004;
+  model.max_participation = 0.1;
+  FillSimulator sim(model);
+  std::vector<double> fills(bars.size()), prices(bars.size());
+  sim.Simulate(bars, schedule, fills, prices);
+  for (size_t i = 0; i < bars.size(); ++i) {
+    double price;
+    EXPECT_DOUBLE_EQ(sim.Fill(bars.Row(i), schedule[i], &price), fills[i]);
+    EXPECT_NEAR(price, prices[i], 1e-9);
+  }
+  sim.Reset();
+  double price;
+  sim.Fill(bars.Row(1), schedule[1], &price);
+  EXPECT_NEAR(price, bars.Row(1).price + model.eta * fills[1], 1e-12);
+}
+
+// Fill pricing over a year of minute bars (365 days x 1440 minutes).
+// Disabled by default; run with --gtest_also_run_disabled_tests.
+TEST(FillSimulatorTest, DISABLED_SimulateYearOfMinuteBars) {
+  MarketDataColumns bars;
+  const size_t n = 365 * 1440;
+  bars.Reserve(n);
+  for (size_t i = 0; i < n; ++i) {
+    bars.Append(static_cast<int64_t>(i) * kNanosPerMinute, 100.0 + (i % 100) * 0.01, 1000.0 + i % 500);
+  }
+  std::vector<double> schedule(n, 100.0), fills(n), prices(n);
+  FillModel model;
+  model.eta = 1e-4;
+  model.gamma = 1e-7;
+  model.max_participation = 0.1;
+  FillSimulator sim(model);
+  const int runs = 20;
+  auto start = std::chrono::steady_clock::now();
+  for (int r = 0; r < runs; ++r) sim.Simulate(bars, schedule, fills, prices);
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / runs;
+  EXPECT_LT(seconds, 0.1);
+  std::cout << "[Log] Simulated " << n << " fills in " << seconds * 1e3 << " ms ("
+            << seconds * 1e9 / n << " ns/bar)" << std::endl;
+}
+
+}  // namespace lvt
@@ -0,0 +1,77 @@
+#include "gtest/gtest.h"
+#include "strategy/incremental_vwap.h"
+#include "strategy/vwap_calculator.h"
+#include <vector>
+
+namespace lvt {
+
+// Test 1: Perfect forecast.
+// Purpose: With realized == expected volumes, slices match the batch schedule.
+TEST(IncrementalVWAPTest, MatchesBatchScheduleWhenForecastIsExact) {
+  MarketDataColumns bars = {{0, 10.0, 100}, {60, 11.0, 300}, {120, 12.0, 0}, {180, 10.5, 600}};
+  VWAPCalculator batch;
+  batch.SetMarketData(bars);
+  batch.ComputeVWAPSchedule(1000);
+
+  IncrementalVWAP vwap;
+  vwap.Start(bars.volume(), 1000);
+  std::vector<double> slices;
+  for (size_t i = 0; i < bars.size(); ++i) {
+    slices.push_back(vwap.NextSlice());
+    vwap.OnBar(bars.Row(i));
+  }
+  ASSERT_EQ(slices.size(), batch.GetSchedule().size());
+  for (size_t i = 0; i < slices.size(); ++i) EXPECT_NEAR(slices[i], batch.GetSchedule()[i], 1e-9);
+  EXPECT_NEAR(vwap.remaining_volume(), 0.0, 1e-9);
+  EXPECT_NEAR(vwap.MarketVWAP(), (1000.0 + 3300.0 + 6300.0) / 1000.0, 1e-12);
+  EXPECT_NEAR(vwap.ExecutionVWAP(), vwap.MarketVWAP(), 1e-12);
+}
+
+// Test 2: Partial fills.
+// Purpose: A shortfall is re-spread over the remaining expected volume.
+TEST(IncrementalVWAPTest, ReallocatesUnfilledQuantity) {
+  std::vector<double> expected = {100, 100, 200};
+  IncrementalVWAP vwap;
+  vwap.Start(expected, 400);
+  EXPECT_DOUBLE_EQ(vwap.NextSlice(), 100);
+  double next = vwap.OnBar({0, 10.0, 100}, 40);  // 60 short
+  EXPECT_DOUBLE_EQ(vwap.remaining_volume(), 360);
+  EXPECT_DOUBLE_EQ(next, 360.0 * 100 / 300);
+  vwap.OnBar({60, 10.0, 100});
+  EXPECT_DOUBLE_EQ(vwap.NextSlice(), 240);
+  EXPECT_EQ(vwap.bars_seen(), 2);
+}
+
+// Test 3: Session overrun and empty forecast tail.
+// Purpose: Zero expected volume spreads evenly; after the last interval the
+// whole remainder is due.
+TEST(IncrementalVWAPTest, HandlesZeroForecastAndOverrun) {
+  std::vector<double> expected = {100, 0, 0};
+  IncrementalVWAP vwap;
+  vwap.Start(expected, 100);
+  vwap.OnBar({0, 1.0, 50}, 40);
+  EXPECT_DOUBLE_EQ(vwap.NextSlice(), 30);  // 60 over two empty intervals
+  vwap.OnBar({60, 1.0, 0}, 0);
+  vwap.OnBar({120, 1.0, 0}, 0);
+  EXPECT_DOUBLE_EQ(vwap.NextSlice(), 60);
+  // Fills are capped at what is left.
+  vwap.OnBar({180, 1.0, 10}, 1000);
+  EXPECT_DOUBLE_EQ(vwap.remaining_volume(), 0);
+  EXPECT_DOUBLE_EQ(vwap.NextSlice(), 0);
+}
+
+// Test 4: Restart.
+// Purpose: Start() clears all running sums.
+TEST(IncrementalVWAPTest, StartResetsState) {
+  std::vector<double> expected = {1, 1};
+  IncrementalVWAP vwap;
+  vwap.Start(expected, 10);
+  vwap.OnBar({0, 5.0, 10});
+  vwap.Start(expected, 20);
+  EXPECT_EQ(vwap.bars_seen(), 0);
+  EXPECT_DOUBLE_EQ(vwap.MarketVWAP(), 0.0);
+  EXPECT_DOUBLE_EQ(vwap.ExecutionVWAP(), 0.0);
+  EXPECT_DOUBLE_EQ(vwap.NextSlice(), 10);
+}
+
+}  // namespace lvt
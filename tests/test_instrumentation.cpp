@@ -0,0 +1,111 @@
+#include "gtest/gtest.h"
+#include "util/instrumentation.h"
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "order/order_manager.h"
+
+namespace lvt {
+
+TEST(LatencyHistogramTest, BucketsCoverEveryValueWithBoundedError) {
+  EXPECT_EQ(LatencyHistogram::BucketIndex(0), 0u);
+  EXPECT_EQ(LatencyHistogram::BucketIndex(31), 31u);
+  EXPECT_EQ(LatencyHistogram::BucketIndex(std::numeric_limits<uint64_t>::max()),
+            LatencyHistogram::kBucketCount - 1);
+  std::vector<uint64_t> values = {0, 1, 31, 32, 33, 63, 64, 65, 1000, 123456789, uint64_t{1} << 40,
+                                  std::numeric_limits<uint64_t>::max()};
+  for (uint64_t v : values) {
+    const size_t i = LatencyHistogram::BucketIndex(v);
+    const uint64_t lower = LatencyHistogram::BucketLowerBound(i);
+    const uint64_t width = LatencyHistogram::BucketWidth(i);
+    EXPECT_LE(lower, v);
+    EXPECT_LE(v - lower, width - 1);
+    EXPECT_LE(static_cast<double>(width), 1.0 + lower / 32.0) << v;
+  }
+  // Buckets are contiguous.
+  for (size_t i = 1; i < 200; ++i) {
+    EXPECT_EQ(LatencyHistogram::BucketLowerBound(i),
+              LatencyHistogram::BucketLowerBound(i - 1) + LatencyHistogram::BucketWidth(i - 1));
+  }
+}
+
+TEST(LatencyHistogramTest, PercentilesWithinBucketPrecision) {
+  LatencyHistogram h;
+  EXPECT_EQ(h.Percentile(0.5), 0u);
+  EXPECT_EQ(h.min(), 0u);
+  for (uint64_t v = 1; v <= 100000; ++v) h.Record(v);
+  EXPECT_EQ(h.count(), 100000u);
+  EXPECT_EQ(h.total(), uint64_t{100000} * 100001 / 2);
+  EXPECT_EQ(h.min(), 1u);
+  EXPECT_EQ(h.max(), 100000u);
+  EXPECT_NEAR(h.Percentile(0.5), 50000.0, 50000 * 0.032);
+  EXPECT_NEAR(h.Percentile(0.99), 99000.0, 99000 * 0.032);
+  EXPECT_NEAR(h.Percentile(0.999), 99900.0, 99900 * 0.032);
+  EXPECT_EQ(h.Percentile(0.0), 1u);
+  EXPECT_EQ(h.Percentile(1.0), 100000u);
+}
+
+TEST(LatencyHistogramTest, MergeAndConcurrentRecord) {
+  LatencyHistogram a, b;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&a, t] {
+      for (uint64_t v = 0; v < 10000; ++v) a.Record(v * 4 + t);
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  EXPECT_EQ(a.count(), 40000u);
+  EXPECT_EQ(a.total(), uint64_t{40000} * 39999 / 2);
+  b.Record(1u << 20);
+  b.Merge(a);
+  EXPECT_EQ(b.count(), 40001u);
+  EXPECT_EQ(b.min(), 0u);
+  EXPECT_EQ(b.max(), 1u << 20);
+  b.Reset();
+  EXPECT_EQ(b.count(), 0u);
+  EXPECT_EQ(b.max(), 0u);
+}
+
+TEST(InstrumentationTest, ScopedTimerRecordsOnlyWhenEnabled) {
+  ResetStageStats();
+  SetStageTimingEnabled(false);
+  { ScopedStageTimer timer(Stage::kOutput); }
+  EXPECT_EQ(StageHistogram(Stage::kOutput).count(), 0u);
+
+  SetStageTimingEnabled(true);
+  {
+    ScopedStageTimer timer(Stage::kOutput);
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  }
+  SetStageTimingEnabled(false);
+  EXPECT_EQ(StageHistogram(Stage::kOutput).count(), 1u);
+  EXPECT_GE(StageHistogram(Stage::kOutput).total(), 2000000u);
+
+  std::ostringstream out;
+  WriteStageStats(out);
+  EXPECT_EQ(out.str().rfind("stage,count,total_ms,mean_us,p50_us,p99_us,p999_us,max_us\noutput,1,", 0), 0u)
+      << out.str();
+  // Stages without samples are left out.
+  EXPECT_EQ(out.str().find("issue_order"), std::string::npos);
+  ResetStageStats();
+}
+
+TEST(InstrumentationTest, OrderManagerIsTimedInInstrumentedBuilds) {
+  ResetStageStats();
+  SetStageTimingEnabled(true);
+  OrderManager orders;
+  for (int i = 0; i < 100; ++i) orders.IssueOrder(1.0, 10.0, i);
+  SetStageTimingEnabled(false);
+#ifdef LVT_ENABLE_INSTRUMENTATION
+  EXPECT_EQ(StageHistogram(Stage::kIssueOrder).count(), 100u);
+#else
+  EXPECT_EQ(StageHistogram(Stage::kIssueOrder).count(), 0u);
+#endif
+  ResetStageStats();
+}
+
+}  // namespace lvt
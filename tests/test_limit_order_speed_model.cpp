@@ -1,6 +1,10 @@
 #include "gtest/gtest.h"
 #include "strategy/limit_order_speed_model.h"
-#include "market/market_simulator.h"
+#include "market/market_data_columns.h"
+#include <chrono>
+#include <iostream>
+#include <limits>
+#include <vector>
 
 namespace lvt {
 
@@ -17,7 +21,8 @@ TEST(LimitOrderSpeedModelTest, EmptyDataZeroVolume) {
 // Expectation: Should return empty schedule.
 TEST(LimitOrderSpeedModelTest, NegativeVolume) {
   LimitOrderSpeedModel model;
-  model.SetMarketData({{"t0", 100, 1}});
+  MarketDataColumns d = {{0, 100, 1}};
+  model.SetMarketData(d);
   model.ComputeOptimalSpeedSchedule(-100, 3);
   EXPECT_TRUE(model.GetSchedule().empty());
 }
@@ -25,7 +30,7 @@ TEST(LimitOrderSpeedModelTest, NegativeVolume) {
 // Test 3: Number of intervals zero, use market data size.
 // Expectation: 2 intervals (from data), split evenly.
 TEST(LimitOrderSpeedModelTest, ZeroIntervalUsesMarketDataSize) {
-  std::vector<MarketData> d = {{"t1", 1, 1},{"t2",2,2}};
+  MarketDataColumns d = {{1, 1, 1},{2,2,2}};
   LimitOrderSpeedModel model;
   model.SetMarketData(d);
   model.ComputeOptimalSpeedSchedule(10, 0);
@@ -39,7 +44,8 @@ TEST(LimitOrderSpeedModelTest, ZeroIntervalUsesMarketDataSize) {
 // Expectation: All volume in one step.
 TEST(LimitOrderSpeedModelTest, SingleInterval) {
   LimitOrderSpeedModel model;
-  model.SetMarketData({{"t1",0,10}});
+  MarketDataColumns d = {{1,0,10}};
+  model.SetMarketData(d);
   model.ComputeOptimalSpeedSchedule(33, 1);
   const auto& sched = model.GetSchedule();
   ASSERT_EQ(sched.size(), 1);
@@ -50,7 +56,7 @@ TEST(LimitOrderSpeedModelTest, SingleInterval) {
 // Expectation: Volume split evenly.
 TEST(LimitOrderSpeedModelTest, FourIntervalEvenSplit) {
   LimitOrderSpeedModel model;
-  std::vector<MarketData> d = {{"t1",1,1},{"t2",2,2},{"t3",3,3},{"t4",4,4}};
+  MarketDataColumns d = {{1,1,1},{2,2,2},{3,3,3},{4,4,4}};
   model.SetMarketData(d);
   model.ComputeOptimalSpeedSchedule(40, 4);
   auto sched = model.GetSchedule();
@@ -58,37 +64,39 @@ TEST(LimitOrderSpeedModelTest, FourIntervalEvenSplit) {
 }
 
 // Test 6: max_speed constrains per-interval volume.
-// Expectation: All chunks hit the maximum speed except remainder.
+// Expectation: All chunks hit the maximum speed; what does not fit is
+// reported as unfilled instead of being dumped on the last interval.
 TEST(LimitOrderSpeedModelTest, MaxSpeedConstrains) {
   LimitOrderSpeedModel model;
-  std::vector<MarketData> d = {{"t0",0,0},{"t1",0,0},{"t2",0,0}};
+  MarketDataColumns d = {{0,0,0},{1,0,0},{2,0,0}};
   model.SetMarketData(d);
   model.ComputeOptimalSpeedSchedule(50, 3, 15);
   const auto& sched = model.GetSchedule();
   ASSERT_EQ(sched.size(), 3);
   EXPECT_DOUBLE_EQ(sched[0], 15.0);
   EXPECT_DOUBLE_EQ(sched[1], 15.0);
-  EXPECT_DOUBLE_EQ(sched[2], 20.0); // Remainder
+  EXPECT_DOUBLE_EQ(sched[2], 15.0);
+  EXPECT_DOUBLE_EQ(model.GetUnfilledVolume(), 5.0);
 }
 
-// Test 7: Remainder logic, doesn't exceed max speed by more than minimally necessary.
-// Purpose: If the leftover is less than max, it's fine to add.
-TEST(LimitOrderSpeedModelTest, RemainderHandledOnLastInterval) {
+// Test 7: No interval exceeds max_speed.
+// Purpose: The remainder is not allowed to break the cap.
+TEST(LimitOrderSpeedModelTest, RemainderNeverExceedsMaxSpeed) {
   LimitOrderSpeedModel model;
-  std::vector<MarketData> d = {{"t1",1,1},{"t2",2,2},{"t3",3,3}};
+  MarketDataColumns d = {{1,1,1},{2,2,2},{3,3,3}};
   model.SetMarketData(d);
   model.ComputeOptimalSpeedSchedule(32, 3, 10.0);
   auto sched = model.GetSchedule();
-  EXPECT_DOUBLE_EQ(sched[0], 10.0);
-  EXPECT_DOUBLE_EQ(sched[1], 10.0);
-  EXPECT_DOUBLE_EQ(sched[2], 12.0);
+  for (auto s : sched) EXPECT_DOUBLE_EQ(s, 10.0);
+  EXPECT_DOUBLE_EQ(model.GetUnfilledVolume(), 2.0);
 }
 
 // Test 8: Schedule matches input intervals if max_speed = 0 (unconstrained)
 // Purpose: Splits evenly without limit.
 TEST(LimitOrderSpeedModelTest, NoMaxSpeedEvenSplit) {
   LimitOrderSpeedModel model;
-  std::vector<MarketData> d(5, {"t", 1, 1});
+  MarketDataColumns d;
+  for (int i = 0; i < 5; ++i) d.Append(i, 1, 1);
   model.SetMarketData(d);
   model.ComputeOptimalSpeedSchedule(25, 5, 0.0);
   auto sched = model.GetSchedule();
@@ -100,7 +108,8 @@ TEST(LimitOrderSpeedModelTest, NoMaxSpeedEvenSplit) {
 // Purpose: Numerical, doesn't lose volume.
 TEST(LimitOrderSpeedModelTest, TotalVolumeMatchesSum) {
   LimitOrderSpeedModel model;
-  std::vector<MarketData> d(7, {"t", 1, 1});
+  MarketDataColumns d;
+  for (int i = 0; i < 7; ++i) d.Append(i, 1, 1);
   model.SetMarketData(d);
   double total_vol = 13;
   model.ComputeOptimalSpeedSchedule(total_vol, 7, 2);
@@ -110,15 +119,88 @@ TEST(LimitOrderSpeedModelTest, TotalVolumeMatchesSum) {
 }
 
 // Test 10: Large number of intervals, small max_speed.
-// Purpose: All but final interval at cap, large last chunk for remainder.
+// Purpose: Every interval at the cap, the excess unfilled.
 TEST(LimitOrderSpeedModelTest, LotOfIntervalsSmallCap) {
   LimitOrderSpeedModel model;
-  std::vector<MarketData> d(10, {"t", 1, 1});
+  MarketDataColumns d;
+  for (int i = 0; i < 10; ++i) d.Append(i, 1, 1);
   model.SetMarketData(d);
   model.ComputeOptimalSpeedSchedule(53, 10, 1);
   auto sched = model.GetSchedule();
-  for (size_t i = 0; i < sched.size()-1; ++i) EXPECT_DOUBLE_EQ(sched[i], 1.0);
-  EXPECT_DOUBLE_EQ(sched.back(), 53-9.0);
+  for (auto s : sched) EXPECT_DOUBLE_EQ(s, 1.0);
+  EXPECT_DOUBLE_EQ(model.GetUnfilledVolume(), 43.0);
+}
+
+// Test 11: Participation cap follows market volume.
+// Purpose: Overflow from thin bars moves to bars with spare capacity and
+// the schedule is as even as the caps allow.
+TEST(LimitOrderSpeedModelTest, ParticipationCapRedistributesOverflow) {
+  LimitOrderSpeedModel model;
+  MarketDataColumns d = {{0,1,100},{1,1,20},{2,1,1000},{3,1,0},{4,1,500}};
+  model.SetMarketData(d);
+  model.ComputeOptimalSpeedSchedule(100, 0, 0.0, 0.1);
+  auto sched = model.GetSchedule();
+  ASSERT_EQ(sched.size(), 5);
+  // Caps are 10, 2, 100, 0, 50: after the two thin bars take 10 and 2 and
+  // the empty one nothing, the other two share the remaining 88 evenly.
+  EXPECT_DOUBLE_EQ(sched[0], 10.0);
+  EXPECT_DOUBLE_EQ(sched[1], 2.0);
+  EXPECT_DOUBLE_EQ(sched[2], 44.0);
+  EXPECT_DOUBLE_EQ(sched[3], 0.0);
+  EXPECT_DOUBLE_EQ(sched[4], 44.0);
+  EXPECT_DOUBLE_EQ(model.GetUnfilledVolume(), 0.0);
+
+  // Both caps together; total capacity 10 + 2 + 30 + 0 + 30 = 72.
+  model.ComputeOptimalSpeedSchedule(100, 0, 30.0, 0.1);
+  sched = model.GetSchedule();
+  EXPECT_DOUBLE_EQ(sched[2], 30.0);
+  EXPECT_DOUBLE_EQ(sched[4], 30.0);
+  EXPECT_DOUBLE_EQ(model.GetUnfilledVolume(), 28.0);
+}
+
+// Test 12: Fewer intervals than bars.
+// Purpose: Each interval's cap uses the volume of all its bars.
+TEST(LimitOrderSpeedModelTest, ParticipationCapAggregatesBarsPerInterval) {
+  LimitOrderSpeedModel model;
+  MarketDataColumns d = {{0,1,10},{1,1,10},{2,1,100},{3,1,100}};
+  model.SetMarketData(d);
+  model.ComputeOptimalSpeedSchedule(30, 2, 0.0, 0.5);
+  auto sched = model.GetSchedule();
+  ASSERT_EQ(sched.size(), 2);
+  EXPECT_DOUBLE_EQ(sched[0], 10.0);
+  EXPECT_DOUBLE_EQ(sched[1], 20.0);
+}
+
+// Test 13: Allocator on its own.
+// Purpose: Unlimited slots absorb everything; no slots leave it all unfilled.
+TEST(LimitOrderSpeedModelTest, AllocateWithinCapacity) {
+  const double inf = std::numeric_limits<double>::infinity();
+  std::vector<double> caps = {inf, 1.0, inf, 3.0};
+  std::vector<double> out(caps.size());
+  EXPECT_DOUBLE_EQ(AllocateWithinCapacity(12, caps, out), 0.0);
+  EXPECT_DOUBLE_EQ(out[0], 4.0);
+  EXPECT_DOUBLE_EQ(out[1], 1.0);
+  EXPECT_DOUBLE_EQ(out[2], 4.0);
+  EXPECT_DOUBLE_EQ(out[3], 3.0);
+  EXPECT_DOUBLE_EQ(AllocateWithinCapacity(5, {}, {}), 5.0);
+}
+
+// Allocation speed for a year of minute intervals with random caps.
+// Disabled by default; run with --gtest_also_run_disabled_tests.
+TEST(LimitOrderSpeedModelTest, DISABLED_MillionIntervalAllocation) {
+  MarketDataColumns d;
+  const size_t n = 365 * 1440;
+  d.Reserve(n);
+  for (size_t i = 0; i < n; ++i) d.Append(static_cast<int64_t>(i), 1, static_cast<double>((i * 7919) % 1000));
+  LimitOrderSpeedModel model;
+  model.SetMarketData(d);
+  auto start = std::chrono::steady_clock::now();
+  model.ComputeOptimalSpeedSchedule(1e7, 0, 100.0, 0.05);
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  double sum = model.GetUnfilledVolume();
+  for (auto x : model.GetSchedule()) sum += x;
+  EXPECT_NEAR(sum, 1e7, 1e-3);
+  std::cout << "[Log] Allocated " << n << " intervals in " << seconds * 1e3 << " ms" << std::endl;
 }
 
 }  // namespace lvt
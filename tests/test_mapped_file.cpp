@@ -0,0 +1,25 @@
+#include "gtest/gtest.h"
+#include "market/mapped_file.h"
+#include <filesystem>
+#include <fstream>
+
+namespace lvt {
+
+TEST(MappedFileTest, OpenFailsForMissingFile) {
+  MappedFile file;
+  EXPECT_FALSE(file.Open("nonexistent.csv"));
+  EXPECT_FALSE(file.is_open());
+}
+
+TEST(MappedFileTest, MapsWholeFileContents) {
+  const auto path = std::filesystem::temp_directory_path() / "lvt_mapped_file_test.txt";
+  { std::ofstream(path) << "t0,1,2\nt1,3,4\n"; }
+  MappedFile file;
+  ASSERT_TRUE(file.Open(path.string(), /*sequential_hint=*/true));
+  EXPECT_EQ(file.view(), "t0,1,2\nt1,3,4\n");
+  file.Close();
+  EXPECT_FALSE(file.is_open());
+  std::filesystem::remove(path);
+}
+
+}  // namespace lvt
@@ -0,0 +1,123 @@
+#include "gtest/gtest.h"
+#include "strategy/market_calibrator.h"
+#include "market/timestamp.h"
+#include "util/thread_pool.h"
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace lvt {
+
+namespace {
+
+// Roll's model: a constant mid with trades at the bid or the ask at random.
+MarketDataColumns BidAskBounce(size_t bars, double mid, double spread) {
+  MarketDataColumns data;
+  uint64_t state = 12345;
+  for (size_t i = 0; i < bars; ++i) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    const double side = (state >> 11) & 1 ? 0.5 : -0.5;
+    data.Append(static_cast<int64_t>(i) * kNanosPerSecond, mid + side * spread, 100.0 + i % 3);
+  }
+  return data;
+}
+
+}  // namespace
+
+TEST(MarketCalibratorTest, RollSpreadRecoversBidAskBounce) {
+  MarketDataColumns data = BidAskBounce(20000, 50.0, 0.04);
+  MarketCalibrator calibrator;
+  calibrator.Add(data);
+  CalibrationResult result = calibrator.Result();
+  EXPECT_EQ(result.bars, 20000);
+  EXPECT_EQ(result.days, 1);
+  EXPECT_NEAR(result.roll_spread, 0.04, 0.002);
+  EXPECT_DOUBLE_EQ(result.spread(), result.roll_spread);
+  // Changes are 0 or +-spread, half of them non-zero.
+  EXPECT_NEAR(result.mean_abs_change, 0.02, 0.001);
+  EXPECT_NEAR(result.sigma, 0.04 / std::sqrt(2.0), 0.001);
+  EXPECT_NEAR(result.mean_price, 50.0, 0.001);
+  EXPECT_NEAR(result.mean_volume, 101.0, 0.01);
+}
+
+TEST(MarketCalibratorTest, OvernightGapsAreNotVolatility) {
+  MarketDataColumns data;
+  for (int day = 0; day < 3; ++day) {
+    for (int m = 0; m < 10; ++m) {
+      data.Append(day * kNanosPerDay + m * kNanosPerMinute, 100.0 + 10 * day + 0.5 * m, 50.0);
+    }
+  }
+  MarketCalibrator calibrator;
+  calibrator.Add(data);
+  CalibrationResult result = calibrator.Result();
+  EXPECT_EQ(result.days, 3);
+  EXPECT_DOUBLE_EQ(result.sigma, 0.0);  // A steady intraday trend only.
+  EXPECT_DOUBLE_EQ(result.roll_spread, 0.0);
+  EXPECT_DOUBLE_EQ(result.spread(), 0.5);  // Falls back to the mean |change|.
+  EXPECT_DOUBLE_EQ(result.daily_volume, 500.0);
+  EXPECT_DOUBLE_EQ(result.volume_stddev, 0.0);
+}
+
+TEST(MarketCalibratorTest, ParametersFollowRulesOfThumb) {
+  CalibrationResult result;
+  result.sigma = 0.2;
+  result.roll_spread = 0.05;
+  result.mean_volume = 1000;
+  result.daily_volume = 390000;
+  AlmgrenKrissParams params = result.ToParameters(3.0);
+  EXPECT_DOUBLE_EQ(params.sigma, 0.2);
+  EXPECT_DOUBLE_EQ(params.lambda, 3.0);
+  EXPECT_DOUBLE_EQ(params.eta, 0.05 / 10.0);
+  EXPECT_DOUBLE_EQ(params.gamma, 0.05 / 39000.0);
+  // Without volume the impact defaults stay.
+  params = CalibrationResult().ToParameters(1.0);
+  EXPECT_DOUBLE_EQ(params.eta, AlmgrenKrissParams().eta);
+  EXPECT_DOUBLE_EQ(params.gamma, AlmgrenKrissParams().gamma);
+}
+
+TEST(MarketCalibratorTest, CalibratesFilesInParallel) {
+  const auto dir = std::filesystem::temp_directory_path() / "lvt_calibrate";
+  std::filesystem::create_directories(dir);
+  std::vector<std::string> paths;
+  std::vector<CalibrationResult> expected;
+  for (int f = 0; f < 3; ++f) {
+    MarketDataColumns data = BidAskBounce(500 + 100 * f, 10.0 * (f + 1), 0.01 * (f + 1));
+    paths.push_back((dir / ("SYM" + std::to_string(f) + ".csv")).string());
+    std::ofstream file(paths.back());
+    file.precision(17);
+    file << "timestamp,price,volume\n";
+    for (size_t i = 0; i < data.size(); ++i) {
+      file << FormatTimestamp(data.epoch_ns()[i]) << "," << data.price()[i] << "," << data.volume()[i] << "\n";
+    }
+    MarketCalibrator calibrator;
+    calibrator.Add(data);
+    expected.push_back(calibrator.Result());
+  }
+
+  ThreadPool pool(2);
+  std::vector<CalibrationResult> results;
+  ASSERT_TRUE(CalibrateFiles(paths, &pool, &results));
+  ASSERT_EQ(results.size(), 3);
+  for (size_t f = 0; f < 3; ++f) {
+    EXPECT_EQ(results[f].bars, expected[f].bars);
+    EXPECT_NEAR(results[f].sigma, expected[f].sigma, 1e-12);
+    EXPECT_NEAR(results[f].roll_spread, expected[f].roll_spread, 1e-12);
+  }
+
+  std::ostringstream out;
+  WriteCalibration(paths, results, out);
+  const std::string table = out.str();
+  EXPECT_EQ(table.rfind("symbol,bars,days,sigma,", 0), 0);
+  EXPECT_NE(table.find("\nSYM2,700,1,"), std::string::npos);
+
+  paths.push_back((dir / "missing.csv").string());
+  EXPECT_FALSE(CalibrateFiles(paths, &pool, &results));
+  std::filesystem::remove_all(dir);
+}
+
+}  // namespace lvt
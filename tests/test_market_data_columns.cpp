@@ -0,0 +1,63 @@
+#include "gtest/gtest.h"
+#include "market/market_data_columns.h"
+#include <memory>
+#include <vector>
+
+namespace lvt {
+
+TEST(MarketDataColumnsTest, AppendFillsEveryColumn) {
+  MarketDataColumns columns;
+  columns.Append(10, 1.5, 100);
+  columns.Append({20, 2.5, 200});
+  ASSERT_EQ(columns.size(), 2);
+  EXPECT_DOUBLE_EQ(columns.price()[1], 2.5);
+  EXPECT_DOUBLE_EQ(columns.volume()[0], 100);
+  EXPECT_EQ(columns.epoch_ns()[1], 20);
+  MarketData row = columns.Row(0);
+  EXPECT_EQ(row.epoch_ns, 10);
+  EXPECT_DOUBLE_EQ(row.price, 1.5);
+}
+
+TEST(MarketDataColumnsTest, TimestampIsFormattedFromEpoch) {
+  MarketDataColumns columns = {{1763994600000000000LL, 273.17, 2295845}};
+  EXPECT_EQ(columns.Timestamp(0), "2025-11-24 14:30:00+00:00");
+}
+
+TEST(MarketDataColumnsTest, ClearEmptiesStore) {
+  MarketDataColumns columns = {{0, 1, 1}, {1, 2, 2}};
+  columns.Clear();
+  EXPECT_TRUE(columns.empty());
+}
+
+TEST(MarketDataColumnsTest, ViewSharesStorage) {
+  MarketDataColumns columns = {{0, 1, 10}, {1, 2, 20}, {2, 3, 30}};
+  MarketDataView view = columns;
+  ASSERT_EQ(view.size(), 3);
+  EXPECT_EQ(view.price().data(), columns.price().data());
+  MarketDataView tail = view.subview(1, 2);
+  ASSERT_EQ(tail.size(), 2);
+  EXPECT_DOUBLE_EQ(tail.volume()[0], 20);
+  EXPECT_EQ(tail.Row(1).epoch_ns, 2);
+}
+
+TEST(MarketDataColumnsTest, BorrowedColumnsAreCopiedOnlyWhenAppendedTo) {
+  auto storage = std::make_shared<std::vector<double>>(std::vector<double>{1, 2, 10, 20});
+  const std::vector<int64_t> epoch_ns = {5, 6};
+  MarketDataColumns columns;
+  columns.Borrow(storage, epoch_ns, std::span<const double>(*storage).first(2),
+                 std::span<const double>(*storage).subspan(2));
+  EXPECT_TRUE(columns.borrowed());
+  EXPECT_EQ(storage.use_count(), 2);
+  EXPECT_EQ(columns.price().data(), storage->data());
+  EXPECT_EQ(columns.Row(1).volume, 20);
+
+  columns.Append(7, 3, 30);
+  EXPECT_FALSE(columns.borrowed());
+  EXPECT_EQ(storage.use_count(), 1);
+  ASSERT_EQ(columns.size(), 3u);
+  EXPECT_EQ(columns.Row(0).epoch_ns, 5);
+  EXPECT_EQ(columns.Row(2).price, 3);
+  EXPECT_NE(columns.price().data(), storage->data());
+}
+
+}  // namespace lvt
@@ -0,0 +1,87 @@
+#include "gtest/gtest.h"
+#include "market/binary_market_data.h"
+#include "market/market_data_reader.h"
+#include "strategy/vwap_calculator.h"
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace lvt {
+
+namespace {
+
+std::filesystem::path WriteSampleCsv(const char* name, int rows) {
+  const auto path = std::filesystem::temp_directory_path() / name;
+  std::ofstream file(path);
+  file << "timestamp,price,volume\n";
+  for (int i = 0; i < rows; ++i) {
+    file << "2025-11-24 14:" << (10 + i % 50) << ":00+00:00," << 100 + i << "," << i + 1 << "\n";
+    if (i % 7 == 0) file << "\n";  // Blank lines are skipped, as in Load()
+  }
+  return path;
+}
+
+}  // namespace
+
+TEST(MarketDataReaderTest, YieldsFixedSizeBatches) {
+  const auto path = WriteSampleCsv("lvt_reader_batches.csv", 25);
+  MarketDataReader reader(path.string(), 10);
+  ASSERT_TRUE(reader.Open());
+  std::vector<size_t> sizes;
+  std::vector<double> prices;
+  ASSERT_TRUE(reader.ForEachBatch([&](MarketDataView batch) {
+    sizes.push_back(batch.size());
+    for (double p : batch.price()) prices.push_back(p);
+    return true;
+  }));
+  std::filesystem::remove(path);
+  EXPECT_EQ(sizes, (std::vector<size_t>{10, 10, 5}));
+  ASSERT_EQ(prices.size(), 25);
+  for (int i = 0; i < 25; ++i) EXPECT_DOUBLE_EQ(prices[i], 100 + i);
+  EXPECT_EQ(reader.stats().lines_processed, 25);
+}
+
+TEST(MarketDataReaderTest, StreamsBinaryFiles) {
+  const auto path = std::filesystem::temp_directory_path() / "lvt_reader_binary.lvtc";
+  MarketDataColumns data;
+  for (int i = 0; i < 7; ++i) data.Append(i, i * 2.0, i * 3.0);
+  ASSERT_TRUE(WriteBinaryMarketData(path.string(), data, {}));
+  MarketDataReader reader(path.string(), 3);
+  size_t batches = 0;
+  double volume = 0;
+  ASSERT_TRUE(reader.ForEachBatch([&](MarketDataView batch) {
+    ++batches;
+    for (double v : batch.volume()) volume += v;
+    return true;
+  }));
+  std::filesystem::remove(path);
+  EXPECT_EQ(batches, 3);
+  EXPECT_DOUBLE_EQ(volume, 63.0);
+}
+
+TEST(MarketDataReaderTest, OpenFailsForMissingFile) {
+  MarketDataReader reader("nonexistent.csv");
+  EXPECT_FALSE(reader.Open());
+}
+
+TEST(MarketDataReaderTest, StreamingVWAPMatchesBatchSchedule) {
+  const auto path = WriteSampleCsv("lvt_reader_vwap.csv", 40);
+  MarketDataColumns all;
+  MarketDataReader reader(path.string(), 6);
+  std::vector<double> streamed;
+  ASSERT_TRUE(VWAPCalculator::ComputeVWAPScheduleStreaming(
+      &reader, 500.0, [&](MarketDataView bars, std::span<const double> schedule) {
+        ASSERT_EQ(bars.size(), schedule.size());
+        for (size_t i = 0; i < bars.size(); ++i) all.Append(bars.Row(i));
+        streamed.insert(streamed.end(), schedule.begin(), schedule.end());
+      }));
+  std::filesystem::remove(path);
+
+  VWAPCalculator calc;
+  calc.SetMarketData(all);
+  calc.ComputeVWAPSchedule(500.0);
+  ASSERT_EQ(streamed.size(), calc.GetSchedule().size());
+  for (size_t i = 0; i < streamed.size(); ++i) EXPECT_DOUBLE_EQ(streamed[i], calc.GetSchedule()[i]);
+}
+
+}  // namespace lvt
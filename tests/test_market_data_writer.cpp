@@ -0,0 +1,49 @@
+#include "gtest/gtest.h"
+#include "market/market_data_writer.h"
+#include "market/market_simulator.h"
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+namespace lvt {
+
+TEST(MarketDataCsvWriterTest, WritesLoadableCsv) {
+  const auto path = std::filesystem::temp_directory_path() / "lvt_writer_round_trip.csv";
+  MarketDataColumns data = {{1732458600000000000, 273.17, 2295845},
+                            {1732458660000000000, 0.1 + 0.2, 1.5}};
+  MarketDataCsvWriter writer;
+  ASSERT_TRUE(writer.Open(path.string()));
+  ASSERT_TRUE(writer.Append(data));
+  ASSERT_TRUE(writer.Finish());
+  EXPECT_FALSE(std::filesystem::exists(path.string() + ".tmp"));
+
+  std::ifstream file(path);
+  std::stringstream ss;
+  ss << file.rdbuf();
+  EXPECT_EQ(ss.str(),
+            "timestamp,price,volume\n"
+            "2024-11-24 14:30:00+00:00,273.17,2295845\n"
+            "2024-11-24 14:31:00+00:00,0.30000000000000004,1.5\n");
+  EXPECT_EQ(writer.bytes_written(), ss.str().size());
+
+  MarketSimulator sim(path.string());
+  ASSERT_TRUE(sim.Load());
+  ASSERT_EQ(sim.GetMarketData().size(), 2);
+  EXPECT_EQ(sim.GetMarketData().price()[1], 0.1 + 0.2);  // Shortest form round-trips.
+  EXPECT_EQ(sim.GetMarketData().epoch_ns()[0], data.epoch_ns()[0]);
+  std::filesystem::remove(path);
+}
+
+TEST(MarketDataCsvWriterTest, UnfinishedFileIsRemoved) {
+  const auto path = std::filesystem::temp_directory_path() / "lvt_writer_abandoned.csv";
+  {
+    MarketDataCsvWriter writer;
+    ASSERT_TRUE(writer.Open(path.string()));
+    MarketDataColumns data = {{0, 1, 1}};
+    ASSERT_TRUE(writer.Append(data));
+  }
+  EXPECT_FALSE(std::filesystem::exists(path));
+  EXPECT_FALSE(std::filesystem::exists(path.string() + ".tmp"));
+}
+
+}  // namespace lvt
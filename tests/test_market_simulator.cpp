@@ -1,5 +1,8 @@
 #include "gtest/gtest.h"
 #include "market/market_simulator.h"
+#include "market/timestamp.h"
+#include <filesystem>
+#include <fstream>
 
 namespace lvt {
 
@@ -8,4 +11,119 @@ TEST(MarketSimulatorTest, LoadReturnsFalseIfFileNotFound) {
   EXPECT_FALSE(sim.Load());
 }
 
+TEST(MarketSimulatorTest, LoadReportsProcessedAndSkippedLines) {
+  const auto path = std::filesystem::temp_directory_path() / "lvt_market_simulator_test.csv";
+  {
+    std::ofstream file(path);
+    file << "timestamp,price,volume\n"
+         << "2025-11-24 14:30:00+00:00,273.17,2295845\n"
+         << "\n"
+         << "2025-11-24 14:31:00+00:00,bad,1\n"
+         << "2025-11-24 14:32:00+00:00,274.5,1000\n";
+  }
+  MarketSimulator sim(path.string());
+  ASSERT_TRUE(sim.Load());
+  std::filesystem::remove(path);
+  const auto& data = sim.GetMarketData();
+  ASSERT_EQ(data.size(), 2);
+  EXPECT_EQ(data.Timestamp(1), "2025-11-24 14:32:00+00:00");
+  EXPECT_DOUBLE_EQ(data.price()[1], 274.5);
+  EXPECT_EQ(sim.GetLoadStats().lines_processed, 2);
+  EXPECT_EQ(sim.GetLoadStats().lines_skipped, 3);
+}
+
+TEST(MarketSimulatorTest, MmapLoadMatchesStreamLoad) {
+  const auto path = std::filesystem::temp_directory_path() / "lvt_market_simulator_mmap.csv";
+  {
+    std::ofstream file(path);
+    file << "timestamp,price,volume\n";
+    for (int i = 0; i < 100; ++i) file << "2025-11-24 14:30:00+00:00," << 100 + i << "," << i << "\n";
+  }
+  MarketSimulator stream_sim(path.string());
+  MarketSimulator mmap_sim(path.string());
+  ASSERT_TRUE(stream_sim.Load(LoadMode::kStream));
+  ASSERT_TRUE(mmap_sim.Load(LoadMode::kMmap));
+  std::filesystem::remove(path);
+  ASSERT_EQ(mmap_sim.GetMarketData().size(), stream_sim.GetMarketData().size());
+  for (size_t i = 0; i < stream_sim.GetMarketData().size(); ++i) {
+    EXPECT_DOUBLE_EQ(mmap_sim.GetMarketData().price()[i], stream_sim.GetMarketData().price()[i]);
+  }
+  EXPECT_EQ(mmap_sim.GetLoadStats().lines_skipped, 1);
+}
+
+TEST(MarketSimulatorTest, LoadsEveryRowWhenTheSizeEstimateIsShort) {
+  // Long rows at the start make the sampled row length overestimate the
+  // rest of the file, so the columns have to grow past the reservation.
+  const auto path = std::filesystem::temp_directory_path() / "lvt_market_simulator_estimate.csv";
+  {
+    std::ofstream file(path);
+    file << "timestamp,price,volume\n";
+    for (int i = 0; i < 2000; ++i) file << "2025-11-24 14:30:00+00:00,100.000000000001,123456789.000000001\n";
+    for (int i = 0; i < 20000; ++i) file << "2025-11-24 14:31:00Z,1,1\n";
+  }
+  MarketSimulator sim(path.string());
+  ASSERT_TRUE(sim.Load(LoadMode::kMmap));
+  std::filesystem::remove(path);
+  EXPECT_EQ(sim.GetMarketData().size(), 22000u);
+}
+
+TEST(MarketSimulatorTest, MmapLoadFallsBackWhenFileMissing) {
+  MarketSimulator sim("nonexistent.csv");
+  EXPECT_FALSE(sim.Load(LoadMode::kMmap));
+}
+
+TEST(MarketSimulatorTest, DayAndWindowLookups) {
+  const auto path = std::filesystem::temp_directory_path() / "lvt_market_simulator_days.csv";
+  {
+    std::ofstream file(path);
+    file << "timestamp,price,volume\n"
+         << "2025-11-24 14:30:00+00:00,1,10\n"
+         << "2025-11-24 14:31:00+00:00,2,10\n"
+         << "2025-11-24 14:32:00+00:00,3,10\n"
+         << "2025-11-25 14:30:00+00:00,4,10\n"
+         << "2025-11-25 14:31:00+00:00,5,10\n";
+  }
+  MarketSimulator sim(path.string());
+  ASSERT_TRUE(sim.Load());
+  std::filesystem::remove(path);
+  ASSERT_EQ(sim.GetDayIndex().day_count(), 2);
+  EXPECT_EQ(sim.GetTradingDay(0).size(), 3);
+  EXPECT_DOUBLE_EQ(sim.GetTradingDay(1).price()[0], 4);
+  EXPECT_TRUE(sim.GetTradingDay(2).empty());
+
+  int64_t t0 = 0;
+  int64_t t1 = 0;
+  ASSERT_TRUE(ParseTimestamp("2025-11-25", &t0));
+  MarketDataView day = sim.GetBarsForDay(EpochDay(t0));
+  ASSERT_EQ(day.size(), 2);
+  EXPECT_DOUBLE_EQ(day.price()[1], 5);
+
+  ASSERT_TRUE(ParseTimestamp("2025-11-24 14:31:00Z", &t0));
+  ASSERT_TRUE(ParseTimestamp("2025-11-25 14:31:00Z", &t1));
+  MarketDataView window = sim.GetBarsInWindow(t0, t1);
+  ASSERT_EQ(window.size(), 3);
+  EXPECT_DOUBLE_EQ(window.price()[0], 2);
+  EXPECT_DOUBLE_EQ(window.price()[2], 4);
+}
+
+TEST(MarketSimulatorTest, FirstSessionWithoutDayIndex) {
+  const auto path = std::filesystem::temp_directory_path() / "lvt_market_simulator_unsorted.csv";
+  {
+    std::ofstream file(path);
+    file << "timestamp,price,volume\n"
+         << "2025-11-24 14:32:00+00:00,3,10\n"
+         << "2025-11-24 14:31:00+00:00,2,10\n"
+         << "2025-11-24 14:30:00+00:00,1,10\n"
+         << "2025-11-25 14:30:00+00:00,4,10\n";
+  }
+  MarketSimulator sim(path.string());
+  ASSERT_TRUE(sim.Load());
+  std::filesystem::remove(path);
+  EXPECT_EQ(sim.GetDayIndex().day_count(), 0u);
+  EXPECT_TRUE(sim.GetTradingDay(0).empty());
+  MarketDataView first = sim.GetFirstSession();
+  ASSERT_EQ(first.size(), 3u);
+  EXPECT_DOUBLE_EQ(first.price()[0], 3);
+}
+
 }  // namespace lvt
@@ -0,0 +1,108 @@
+#include "gtest/gtest.h"
+#include "engine/monte_carlo_engine.h"
+#include "strategy/almgren_kriss_model.h"
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+namespace lvt {
+
+TEST(MonteCarloCostEngineTest, MomentsMatchAlmgrenKrissCost) {
+  std::vector<double> prices(60, 100.0);
+  AlmgrenKrissModel ak;
+  ak.SetParameters(0.5, 0.02, 0.3, 0.1);
+  ak.SetMarketData(prices, 1000);
+  ak.ComputeOptimalSchedule();
+
+  MonteCarloConfig config;
+  config.paths = 100000;
+  config.seed = 11;
+  config.eta = 0.5;
+  config.gamma = 0.02;
+  config.sigma = 0.3;
+  MonteCarloCostEngine engine(config);
+  CostDistribution result;
+  ThreadPool pool(2);
+  ASSERT_TRUE(engine.Evaluate(ak.GetSchedule(), &pool, &result));
+
+  const double sd = std::sqrt(ak.CostVariance());
+  EXPECT_EQ(result.paths, config.paths);
+  EXPECT_NEAR(result.mean, ak.ExpectedCost(), 4 * sd / std::sqrt(config.paths));
+  EXPECT_NEAR(result.variance / ak.CostVariance(), 1.0, 0.02);
+  // The cost is Gaussian under this model.
+  ASSERT_EQ(result.quantiles.size(), 4);
+  EXPECT_NEAR(result.quantiles[1], ak.ExpectedCost(), 0.02 * sd);
+  EXPECT_NEAR(result.quantiles[2], ak.ExpectedCost() + 1.6449 * sd, 0.03 * sd);
+  EXPECT_LT(result.quantiles[0], result.quantiles[1]);
+  EXPECT_LT(result.quantiles[2], result.quantiles[3]);
+}
+
+TEST(MonteCarloCostEngineTest, ZeroSigmaLeavesOnlyImpactCost) {
+  std::vector<double> schedule = {10, 20, 30};
+  MonteCarloConfig config;
+  config.paths = 10;
+  config.eta = 0.1;
+  config.gamma = 0.01;
+  config.sigma = 0.0;
+  CostDistribution result;
+  ASSERT_TRUE(MonteCarloCostEngine(config).Evaluate(schedule, nullptr, &result));
+  // eta * (100 + 400 + 900) + gamma * (20 * 10 + 30 * 30)
+  const double expected = 0.1 * 1400 + 0.01 * 1100;
+  EXPECT_DOUBLE_EQ(result.mean, expected);
+  EXPECT_DOUBLE_EQ(result.variance, 0.0);
+  for (double q : result.quantiles) EXPECT_DOUBLE_EQ(q, expected);
+}
+
+TEST(MonteCarloCostEngineTest, ResultsDependOnSeedButNotOnThreads) {
+  std::vector<double> schedule(37, 5.0);
+  MonteCarloConfig config;
+  config.paths = 5000;  // Not a multiple of the per-task block.
+  config.seed = 3;
+  MonteCarloCostEngine serial(config);
+  MonteCarloCostEngine parallel(config);
+  CostDistribution a, b;
+  ThreadPool pool(4);
+  ASSERT_TRUE(serial.Evaluate(schedule, nullptr, &a));
+  ASSERT_TRUE(parallel.Evaluate(schedule, &pool, &b));
+  EXPECT_EQ(serial.GetPathCosts(), parallel.GetPathCosts());
+  EXPECT_EQ(a.mean, b.mean);
+
+  config.seed = 4;
+  MonteCarloCostEngine reseeded(config);
+  ASSERT_TRUE(reseeded.Evaluate(schedule, nullptr, &b));
+  EXPECT_NE(a.mean, b.mean);
+}
+
+TEST(MonteCarloCostEngineTest, RejectsInvalidConfig) {
+  std::vector<double> schedule = {1, 1};
+  CostDistribution result;
+  MonteCarloConfig config;
+  config.paths = 0;
+  EXPECT_FALSE(MonteCarloCostEngine(config).Evaluate(schedule, nullptr, &result));
+  config = MonteCarloConfig();
+  config.quantiles = {0.5, 1.5};
+  EXPECT_FALSE(MonteCarloCostEngine(config).Evaluate(schedule, nullptr, &result));
+  config = MonteCarloConfig();
+  config.sigma = -1;
+  EXPECT_FALSE(MonteCarloCostEngine(config).Evaluate(schedule, nullptr, &result));
+}
+
+// A million paths over a 390-minute session on all cores.
+// Disabled by default; run with --gtest_also_run_disabled_tests.
+TEST(MonteCarloCostEngineTest, DISABLED_MillionPaths) {
+  std::vector<double> schedule(390, 1000.0 / 390);
+  MonteCarloConfig config;
+  config.paths = 1000000;
+  MonteCarloCostEngine engine(config);
+  CostDistribution result;
+  ThreadPool pool;
+  auto start = std::chrono::steady_clock::now();
+  ASSERT_TRUE(engine.Evaluate(schedule, &pool, &result));
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  std::cout << "[Log] " << config.paths << " paths x " << schedule.size() << " intervals on "
+            << pool.size() << " threads in " << seconds * 1e3 << " ms (mean " << result.mean
+            << ", sd " << std::sqrt(result.variance) << ")" << std::endl;
+}
+
+}  // namespace lvt
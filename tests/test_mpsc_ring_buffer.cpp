@@ -0,0 +1,57 @@
+#include "gtest/gtest.h"
+#include "util/mpsc_ring_buffer.h"
+#include <thread>
+#include <vector>
+
+namespace lvt {
+
+TEST(MpscRingBufferTest, FifoAndFullSignal) {
+  MpscRingBuffer<int> ring(3);
+  EXPECT_EQ(ring.capacity(), 4);
+  int value = 0;
+  EXPECT_FALSE(ring.TryPop(&value));
+  for (int i = 0; i < 4; ++i) EXPECT_TRUE(ring.TryPush(i));
+  EXPECT_FALSE(ring.TryPush(4));
+  ASSERT_TRUE(ring.TryPop(&value));
+  EXPECT_EQ(value, 0);
+  EXPECT_TRUE(ring.TryPush(4));  // The freed slot is reused.
+  for (int expected = 1; expected <= 4; ++expected) {
+    ASSERT_TRUE(ring.TryPop(&value));
+    EXPECT_EQ(value, expected);
+  }
+  EXPECT_FALSE(ring.TryPop(&value));
+}
+
+TEST(MpscRingBufferTest, ManyProducersDeliverEveryValueInProducerOrder) {
+  struct Item {
+    int producer;
+    int seq;
+  };
+  const int kProducers = 8;
+  const int kPerProducer = 20000;
+  MpscRingBuffer<Item> ring(64);
+  std::vector<std::thread> producers;
+  for (int p = 0; p < kProducers; ++p) {
+    producers.emplace_back([&ring, p] {
+      for (int i = 0; i < kPerProducer; ++i) {
+        while (!ring.TryPush({p, i})) std::this_thread::yield();
+      }
+    });
+  }
+  std::vector<int> next(kProducers, 0);
+  int received = 0;
+  Item item;
+  while (received < kProducers * kPerProducer) {
+    if (!ring.TryPop(&item)) {
+      std::this_thread::yield();
+      continue;
+    }
+    ASSERT_EQ(item.seq, next[item.producer]);
+    ++next[item.producer];
+    ++received;
+  }
+  for (auto& t : producers) t.join();
+  EXPECT_FALSE(ring.TryPop(&item));
+}
+
+}  // namespace lvt
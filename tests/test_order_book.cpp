@@ -0,0 +1,168 @@
+#include "gtest/gtest.h"
+#include "market/order_book.h"
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+namespace lvt {
+
+TEST(OrderBookTest, RestsOrdersAndTracksBestPrices) {
+  OrderBook book(1000, 100, 16);
+  EXPECT_FALSE(book.HasBid());
+  EXPECT_FALSE(book.HasAsk());
+  book.AddLimit(Side::kBuy, 1010, 5);
+  book.AddLimit(Side::kBuy, 1012, 3);
+  book.AddLimit(Side::kSell, 1015, 4);
+  book.AddLimit(Side::kSell, 1014, 2);
+  EXPECT_EQ(book.best_bid(), 1012);
+  EXPECT_EQ(book.best_ask(), 1014);
+  EXPECT_DOUBLE_EQ(book.DepthAt(Side::kBuy, 1010), 5);
+  EXPECT_EQ(book.order_count(), 4);
+}
+
+TEST(OrderBookTest, MatchesCrossingOrdersInPriceTimePriority) {
+  OrderBook book(0, 100, 16);
+  OrderId first = book.AddLimit(Side::kSell, 50, 3);
+  OrderId second = book.AddLimit(Side::kSell, 50, 4);
+  OrderId higher = book.AddLimit(Side::kSell, 51, 5);
+
+  double filled;
+  OrderId rest = book.AddLimit(Side::kBuy, 50, 5, &filled);
+  EXPECT_DOUBLE_EQ(filled, 5);
+  EXPECT_EQ(rest, kNoOrder);
+  EXPECT_DOUBLE_EQ(book.RemainingQuantity(first), 0);  // Filled first.
+  EXPECT_DOUBLE_EQ(book.RemainingQuantity(second), 2);
+  EXPECT_DOUBLE_EQ(book.RemainingQuantity(higher), 5);
+
+  // Sweeps 50 and part of 51, leaving the best ask at 51.
+  EXPECT_DOUBLE_EQ(book.ExecuteMarket(Side::kBuy, 4), 4);
+  EXPECT_EQ(book.best_ask(), 51);
+  EXPECT_DOUBLE_EQ(book.DepthAt(Side::kSell, 51), 3);
+
+  // A buy through the remaining ask rests its leftover as the new best bid.
+  rest = book.AddLimit(Side::kBuy, 52, 10, &filled);
+  EXPECT_DOUBLE_EQ(filled, 3);
+  EXPECT_FALSE(book.HasAsk());
+  EXPECT_EQ(book.best_bid(), 52);
+  EXPECT_DOUBLE_EQ(book.RemainingQuantity(rest), 7);
+  EXPECT_DOUBLE_EQ(book.ExecuteMarket(Side::kSell, 100), 7);
+  EXPECT_EQ(book.order_count(), 0);
+}
+
+TEST(OrderBookTest, QueuePositionAdvancesAsOrdersAheadFillOrCancel) {
+  OrderBook book(0, 10, 16);
+  OrderId a = book.AddLimit(Side::kBuy, 5, 10);
+  OrderId b = book.AddLimit(Side::kBuy, 5, 20);
+  OrderId mine = book.AddLimit(Side::kBuy, 5, 7);
+  book.AddLimit(Side::kBuy, 5, 30);
+  EXPECT_DOUBLE_EQ(book.QueueAhead(mine), 30);
+
+  book.ExecuteMarket(Side::kSell, 4);
+  EXPECT_DOUBLE_EQ(book.QueueAhead(mine), 26);
+  EXPECT_TRUE(book.Cancel(b));
+  EXPECT_DOUBLE_EQ(book.QueueAhead(mine), 6);
+  EXPECT_TRUE(book.Reduce(a, 1));
+  EXPECT_DOUBLE_EQ(book.QueueAhead(mine), 1);
+  EXPECT_DOUBLE_EQ(book.DepthAt(Side::kBuy, 5), 38);
+
+  // Flow reaches our order only after everything ahead of it.
+  book.ExecuteMarket(Side::kSell, 3);
+  EXPECT_DOUBLE_EQ(book.QueueAhead(mine), 0);
+  EXPECT_DOUBLE_EQ(book.RemainingQuantity(mine), 5);
+  EXPECT_EQ(book.OrdersAt(Side::kBuy, 5), 2);
+}
+
+TEST(OrderBookTest, CancelRescansBestPrice) {
+  OrderBook book(0, 100, 16);
+  book.AddLimit(Side::kSell, 40, 1);
+  OrderId best = book.AddLimit(Side::kSell, 30, 1);
+  book.AddLimit(Side::kBuy, 10, 1);
+  OrderId best_bid = book.AddLimit(Side::kBuy, 20, 1);
+  EXPECT_TRUE(book.Cancel(best));
+  EXPECT_TRUE(book.Cancel(best_bid));
+  EXPECT_EQ(book.best_ask(), 40);
+  EXPECT_EQ(book.best_bid(), 10);
+  EXPECT_FALSE(book.Cancel(best));  // Already gone.
+}
+
+TEST(OrderBookTest, StaleIdsDoNotAliasReusedSlots) {
+  OrderBook book(0, 10, 1);
+  OrderId old_id = book.AddLimit(Side::kBuy, 3, 1);
+  ASSERT_TRUE(book.Cancel(old_id));
+  OrderId new_id = book.AddLimit(Side::kBuy, 3, 2);
+  ASSERT_NE(new_id, kNoOrder);
+  EXPECT_NE(new_id, old_id);
+  EXPECT_FALSE(book.Cancel(old_id));
+  EXPECT_DOUBLE_EQ(book.RemainingQuantity(old_id), 0);
+  EXPECT_DOUBLE_EQ(book.RemainingQuantity(new_id), 2);
+  EXPECT_DOUBLE_EQ(book.QueueAhead(old_id), -1);
+}
+
+TEST(OrderBookTest, RejectsInvalidOrders) {
+  OrderBook book(100, 10, 1);
+  EXPECT_EQ(book.AddLimit(Side::kBuy, 99, 1), kNoOrder);
+  EXPECT_EQ(book.AddLimit(Side::kBuy, 110, 1), kNoOrder);
+  EXPECT_EQ(book.AddLimit(Side::kBuy, 105, 0), kNoOrder);
+  ASSERT_NE(book.AddLimit(Side::kBuy, 105, 1), kNoOrder);
+  EXPECT_EQ(book.AddLimit(Side::kBuy, 104, 1), kNoOrder);  // Pool is full.
+  // A crossing order still matches without needing a pool slot.
+  double filled;
+  EXPECT_EQ(book.AddLimit(Side::kSell, 105, 1, &filled), kNoOrder);
+  EXPECT_DOUBLE_EQ(filled, 1);
+  EXPECT_EQ(book.order_count(), 0);
+}
+
+TEST(OrderBookTest, ClearEmptiesTheBook) {
+  OrderBook book(0, 10, 4);
+  OrderId id = book.AddLimit(Side::kSell, 5, 1);
+  book.Clear();
+  EXPECT_EQ(book.order_count(), 0);
+  EXPECT_FALSE(book.HasAsk());
+  EXPECT_FALSE(book.Cancel(id));
+  for (int i = 0; i < 4; ++i) EXPECT_NE(book.AddLimit(Side::kBuy, i, 1), kNoOrder);
+}
+
+// Message rate for synthetic flow around a fixed mid: adds, cancels and
+// market orders in 45/45/10 proportions.
+// Disabled by default; run with --gtest_also_run_disabled_tests.
+TEST(OrderBookTest, DISABLED_SyntheticFlowThroughput) {
+  const int64_t mid = 50000;
+  OrderBook book(mid - 5000, 10000, 1 << 20);
+  std::vector<OrderId> live;
+  live.reserve(1 << 20);
+  uint64_t state = 42;
+  auto next = [&state]() {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+  };
+  const size_t messages = 10000000;
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < messages; ++i) {
+    const uint64_t r = next();
+    const uint64_t kind = r % 100;
+    if (kind < 45 || live.empty()) {
+      const bool buy = (r >> 8) & 1;
+      const int64_t offset = 1 + static_cast<int64_t>((r >> 9) % 50);
+      OrderId id = book.AddLimit(buy ? Side::kBuy : Side::kSell, buy ? mid - offset : mid + offset,
+                                 1 + static_cast<double>((r >> 20) % 100));
+      if (id != kNoOrder) live.push_back(id);
+    } else if (kind < 90) {
+      const size_t k = (r >> 8) % live.size();
+      book.Cancel(live[k]);  // May already be filled; then it is a no-op.
+      live[k] = live.back();
+      live.pop_back();
+    } else {
+      book.ExecuteMarket((r >> 8) & 1 ? Side::kBuy : Side::kSell, 1 + static_cast<double>((r >> 20) % 200));
+    }
+  }
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  double rate = messages / seconds;
+  EXPECT_GT(rate, 1e6);
+  std::cout << "[Log] " << messages << " messages in " << seconds * 1e3 << " ms (" << rate / 1e6
+            << "M msg/s, " << book.order_count() << " resting)" << std::endl;
+}
+
+}  // namespace lvt
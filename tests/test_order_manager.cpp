@@ -1,11 +1,188 @@
 #include "gtest/gtest.h"
 #include "order/order_manager.h"
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <memory_resource>
+#include <thread>
+#include <vector>
 
 namespace lvt {
 
+namespace {
+
+// Forwards to the default resource and counts allocations.
+class CountingResource : public std::pmr::memory_resource {
+ public:
+  size_t allocations = 0;
+
+ private:
+  void* do_allocate(size_t bytes, size_t alignment) override {
+    ++allocations;
+    return std::pmr::get_default_resource()->allocate(bytes, alignment);
+  }
+  void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+    std::pmr::get_default_resource()->deallocate(p, bytes, alignment);
+  }
+  bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+    return this == &other;
+  }
+};
+
+}  // namespace
+
 TEST(OrderManagerTest, ExecutionRecordInitiallyEmpty) {
   OrderManager mgr;
   EXPECT_TRUE(mgr.GetExecutions().empty());
 }
 
+TEST(OrderManagerTest, IssueOrderRecordsFieldsAndSequentialIds) {
+  OrderManager mgr;
+  EXPECT_EQ(mgr.IssueOrder(10, 101.5, 1000), 1);
+  EXPECT_EQ(mgr.IssueOrder(20, 102.5, 2000), 2);
+  auto records = mgr.GetExecutions();
+  ASSERT_EQ(records.size(), 2);
+  EXPECT_EQ(records[1].order_id, 2);
+  EXPECT_DOUBLE_EQ(records[1].quantity, 20);
+  EXPECT_DOUBLE_EQ(records[1].price, 102.5);
+  EXPECT_EQ(records[1].epoch_ns, 2000);
+}
+
+TEST(OrderManagerTest, NoAllocationsWithinReservedCapacity) {
+  CountingResource counting;
+  OrderManager mgr(&counting);
+  mgr.Reserve(1000);
+  const size_t after_reserve = counting.allocations;
+  EXPECT_EQ(after_reserve, 1);
+  for (int i = 0; i < 1000; ++i) mgr.IssueOrder(1, 100, i);
+  EXPECT_EQ(counting.allocations, after_reserve);
+
+  // Clear keeps the storage, so a second replay does not allocate either.
+  mgr.Clear();
+  EXPECT_EQ(mgr.capacity(), 1000);
+  for (int i = 0; i < 1000; ++i) mgr.IssueOrder(1, 100, i);
+  EXPECT_EQ(counting.allocations, after_reserve);
+  EXPECT_EQ(mgr.GetExecutions().front().order_id, 1001);
+
+  mgr.IssueOrder(1, 100, 0);  // Beyond capacity: grows through the resource
+  EXPECT_GT(counting.allocations, after_reserve);
+}
+
+TEST(OrderManagerTest, RecordsCanLiveInAnArena) {
+  std::array<std::byte, 64 * sizeof(ExecutionRecord)> buffer;
+  std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size(),
+                                            std::pmr::null_memory_resource());
+  OrderManager mgr(&arena);
+  mgr.Reserve(32);
+  for (int i = 0; i < 32; ++i) mgr.IssueOrder(i, 1, i);
+  auto* first = reinterpret_cast<const std::byte*>(mgr.GetExecutions().data());
+  EXPECT_GE(first, buffer.data());
+  EXPECT_LT(first, buffer.data() + buffer.size());
+}
+
+// Replay throughput of IssueOrder into a reserved store. Disabled by default;
+// run with --gtest_also_run_disabled_tests. The order count is set through
+// LVT_ORDER_REPLAY_COUNT (default 10^7).
+TEST(OrderManagerTest, DISABLED_ReplayThroughput) {
+  size_t count = 10000000;
+  if (const char* env = std::getenv("LVT_ORDER_REPLAY_COUNT")) count = std::strtoull(env, nullptr, 10);
+  CountingResource counting;
+  OrderManager mgr(&counting);
+  mgr.Reserve(count);
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < count; ++i) mgr.IssueOrder(1.0, 100.0 + (i & 7), static_cast<int64_t>(i));
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  EXPECT_EQ(counting.allocations, 1);
+  std::cout << "[Log] " << count << " orders in " << seconds << " s (" << count / seconds / 1e6
+            << " M orders/s)" << std::endl;
+}
+
+TEST(OrderManagerTest, ConcurrentSubmissionsGetUniqueIds) {
+  const int kProducers = 8;
+  const int kPerProducer = 5000;
+  OrderManager mgr(256);
+  std::atomic<int> producers_done{0};
+  std::vector<std::thread> producers;
+  for (int p = 0; p < kProducers; ++p) {
+    producers.emplace_back([&, p] {
+      for (int i = 0; i < kPerProducer; ++i) mgr.SubmitOrder(1.0, 100.0, p);
+      producers_done++;
+    });
+  }
+  // This thread is the single consumer.
+  while (producers_done.load() < kProducers) {
+    if (mgr.DrainSubmissions() == 0) std::this_thread::yield();
+  }
+  mgr.DrainSubmissions();
+  for (auto& t : producers) t.join();
+
+  EXPECT_EQ(mgr.IssueOrder(1.0, 100.0, 0), kProducers * kPerProducer + 1);
+  std::vector<int64_t> ids;
+  for (const auto& r : mgr.GetExecutions()) ids.push_back(r.order_id);
+  ASSERT_EQ(ids.size(), kProducers * kPerProducer + 1);
+  std::sort(ids.begin(), ids.end());
+  for (size_t i = 0; i < ids.size(); ++i) EXPECT_EQ(ids[i], static_cast<int64_t>(i) + 1);
+}
+
+TEST(OrderManagerTest, DrainRespectsLimitAndNeedsQueue) {
+  OrderManager mgr(8);
+  for (int i = 0; i < 5; ++i) mgr.SubmitOrder(i, 1, i);
+  EXPECT_EQ(mgr.DrainSubmissions(3), 3);
+  EXPECT_EQ(mgr.DrainSubmissions(), 2);
+  EXPECT_EQ(mgr.GetExecutions()[4].quantity, 4);
+  OrderManager plain;
+  EXPECT_EQ(plain.DrainSubmissions(), 0);
+}
+
+TEST(OrderManagerTest, SubmitWithoutQueueFails) {
+  OrderManager mgr;
+  EXPECT_EQ(mgr.SubmitOrder(10, 101.5, 1000), -1);
+  EXPECT_EQ(mgr.DrainSubmissions(), 0);
+  // No id was taken.
+  EXPECT_EQ(mgr.IssueOrder(10, 101.5, 1000), 1);
+}
+
+// SubmitOrder latency percentiles with 1..64 producers and one draining
+// consumer. Disabled by default; run with --gtest_also_run_disabled_tests.
+TEST(OrderManagerTest, DISABLED_SubmitLatencyPercentiles) {
+  using Clock = std::chrono::steady_clock;
+  const size_t kOrdersPerRun = 1 << 20;
+  for (int producers : {1, 2, 4, 8, 16, 32, 64}) {
+    OrderManager mgr(1 << 16);
+    mgr.Reserve(kOrdersPerRun);
+    const size_t per_producer = kOrdersPerRun / producers;
+    std::vector<std::vector<int64_t>> latencies(producers);
+    std::atomic<int> done{0};
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+      threads.emplace_back([&, p] {
+        auto& lat = latencies[p];
+        lat.reserve(per_producer);
+        for (size_t i = 0; i < per_producer; ++i) {
+          auto start = Clock::now();
+          mgr.SubmitOrder(1.0, 100.0, static_cast<int64_t>(i));
+          lat.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+        }
+        done++;
+      });
+    }
+    while (done.load() < producers) {
+      if (mgr.DrainSubmissions() == 0) std::this_thread::yield();
+    }
+    mgr.DrainSubmissions();
+    for (auto& t : threads) t.join();
+    EXPECT_EQ(mgr.size(), per_producer * producers);
+
+    std::vector<int64_t> all;
+    for (auto& lat : latencies) all.insert(all.end(), lat.begin(), lat.end());
+    std::sort(all.begin(), all.end());
+    auto pct = [&](double q) { return all[static_cast<size_t>(q * (all.size() - 1))]; };
+    std::cout << "[Log] producers=" << producers << " p50=" << pct(0.5) << "ns p99=" << pct(0.99)
+              << "ns p99.9=" << pct(0.999) << "ns max=" << all.back() << "ns" << std::endl;
+  }
+}
+
 }  // namespace lvt
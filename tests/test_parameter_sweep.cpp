@@ -0,0 +1,117 @@
+#include "gtest/gtest.h"
+#include "market/timestamp.h"
+#include "strategy/almgren_kriss_model.h"
+#include "strategy/parameter_sweep.h"
+#include "util/thread_pool.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace lvt {
+
+TEST(ParameterSweepTest, ParsesValueLists) {
+  std::vector<double> values;
+  ASSERT_TRUE(ParseParameterValues("0.1, 1,+10", &values));
+  EXPECT_EQ(values, (std::vector<double>{0.1, 1, 10}));
+  EXPECT_FALSE(ParseParameterValues("1,,2", &values));
+  EXPECT_FALSE(ParseParameterValues("1,abc", &values));
+  EXPECT_FALSE(ParseParameterValues("", &values));
+  EXPECT_FALSE(ParseParameterValues("++1", &values));
+  EXPECT_FALSE(ParseParameterValues("+ +2", &values));
+  EXPECT_FALSE(ParseParameterValues("++-1", &values));
+  EXPECT_FALSE(ParseParameterValues("+-1", &values));
+  EXPECT_EQ(values.size(), 3);  // Untouched on failure
+}
+
+TEST(ParameterSweepTest, GridIsCartesianProductWithLambdaFastest) {
+  std::vector<double> etas = {1, 2}, gammas = {0.1}, sigmas = {0.5}, lambdas = {1, 10, 100};
+  auto grid = MakeParameterGrid(etas, gammas, sigmas, lambdas);
+  ASSERT_EQ(grid.size(), 6);
+  EXPECT_DOUBLE_EQ(grid[0].eta, 1);
+  EXPECT_DOUBLE_EQ(grid[1].lambda, 10);
+  EXPECT_DOUBLE_EQ(grid[3].eta, 2);
+  EXPECT_DOUBLE_EQ(grid[3].lambda, 1);
+}
+
+TEST(ParameterSweepTest, LoadsParameterSetsFromCsv) {
+  const auto path = std::filesystem::temp_directory_path() / "lvt_sweep_sets.csv";
+  {
+    std::ofstream file(path);
+    file << "eta,gamma,sigma,lambda\n1,0.01,0.5,1\n\n2,0.02,0.4,3\n";
+  }
+  std::vector<AlmgrenKrissParams> sets;
+  ASSERT_TRUE(LoadParameterSets(path.string(), &sets));
+  ASSERT_EQ(sets.size(), 2);
+  EXPECT_DOUBLE_EQ(sets[1].sigma, 0.4);
+  {
+    std::ofstream file(path);
+    file << "1,0.01,0.5\n";
+  }
+  EXPECT_FALSE(LoadParameterSets(path.string(), &sets));
+  std::filesystem::remove(path);
+}
+
+TEST(ParameterSweepTest, ResultsMatchSingleModelRuns) {
+  std::vector<double> prices(50, 1.0);
+  std::vector<double> etas = {0.5, 1}, gammas = {0.01}, sigmas = {0.5}, lambdas = {0.1, 1, 10};
+  auto grid = MakeParameterGrid(etas, gammas, sigmas, lambdas);
+  ParameterSweep sweep;
+  sweep.SetSessions({prices}, 1000);
+  ThreadPool pool(3);
+  sweep.Run(grid, &pool);
+  const auto& results = sweep.GetResults();
+  ASSERT_EQ(results.size(), grid.size());
+  for (size_t i = 0; i < grid.size(); ++i) {
+    AlmgrenKrissModel model;
+    model.SetParameters(grid[i].eta, grid[i].gamma, grid[i].sigma, grid[i].lambda);
+    model.SetMarketData(prices, 1000);
+    model.ComputeOptimalSchedule();
+    EXPECT_DOUBLE_EQ(results[i].params.lambda, grid[i].lambda);
+    EXPECT_NEAR(results[i].expected_cost, model.ExpectedCost(), 1e-9 * model.ExpectedCost());
+    EXPECT_NEAR(results[i].variance, model.CostVariance(), 1e-9 * model.CostVariance());
+  }
+  std::ostringstream out;
+  sweep.WriteResults(out);
+  const std::string table = out.str();
+  EXPECT_EQ(table.substr(0, table.find('\n')), "eta,gamma,sigma,lambda,expected_cost,variance");
+  EXPECT_EQ(std::count(table.begin(), table.end(), '\n'), 7);
+}
+
+TEST(ParameterSweepTest, RealizesSchedulesWithTheFillModel) {
+  MarketDataColumns bars;
+  for (int i = 0; i < 40; ++i) bars.Append(i * kNanosPerMinute, 100.0 + i % 3, 20.0 + i % 7 * 10);
+  std::vector<AlmgrenKrissParams> sets = {{1, 0.01, 0.5, 0.1}, {1, 0.01, 0.5, 10}};
+  FillModel model;
+  model.eta = 0.01;
+  model.gamma = 0.001;
+  model.max_participation = 0.5;
+  ParameterSweep sweep;
+  sweep.SetSessions({bars.price()}, 1000);
+  sweep.SetFillModel(bars, model);
+  sweep.Run(sets);
+  const auto& results = sweep.GetResults();
+  ASSERT_EQ(results.size(), 2u);
+  const FillSimulator simulator(model);
+  for (size_t i = 0; i < sets.size(); ++i) {
+    AlmgrenKrissModel ak;
+    ak.SetParameters(sets[i].eta, sets[i].gamma, sets[i].sigma, sets[i].lambda);
+    ak.SetMarketData(bars.price(), 1000);
+    ak.ComputeOptimalSchedule();
+    std::vector<double> fills(bars.size()), prices(bars.size());
+    simulator.Simulate(bars, ak.GetSchedule(), fills, prices);
+    const FillSummary expected = simulator.Summarize(bars, fills, prices);
+    EXPECT_NEAR(results[i].fills.filled_volume, expected.filled_volume, 1e-9);
+    EXPECT_NEAR(results[i].fills.impact_cost, expected.impact_cost, 1e-9);
+    EXPECT_LT(results[i].fills.filled_volume, 1000);  // The cap binds.
+    EXPECT_GT(results[i].fills.impact_cost, 0);
+  }
+  std::ostringstream out;
+  sweep.WriteResults(out);
+  EXPECT_EQ(out.str().substr(0, out.str().find('\n')),
+            "eta,gamma,sigma,lambda,expected_cost,variance,filled_volume,impact_cost");
+}
+
+}  // namespace lvt
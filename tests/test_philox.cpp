@@ -0,0 +1,36 @@
+#include "gtest/gtest.h"
+#include "util/philox.h"
+#include <cmath>
+
+namespace lvt {
+
+// Known-answer vectors from the Random123 distribution (kat_vectors).
+TEST(PhiloxTest, MatchesReferenceVectors) {
+  auto zero = Philox4x32::Generate({0, 0, 0, 0}, {0, 0});
+  EXPECT_EQ(zero, (Philox4x32::Counter{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}));
+  auto ones = Philox4x32::Generate({0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff},
+                                   {0xffffffff, 0xffffffff});
+  EXPECT_EQ(ones, (Philox4x32::Counter{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}));
+  auto pi = Philox4x32::Generate({0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344},
+                                 {0xa4093822, 0x299f31d0});
+  EXPECT_EQ(pi, (Philox4x32::Counter{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}));
+}
+
+TEST(PhiloxTest, NormalsHaveUnitMoments) {
+  const int blocks = 50000;
+  double sum = 0.0, sum_sq = 0.0;
+  for (int b = 0; b < blocks; ++b) {
+    for (double z : NormalBlock(Philox4x32::Generate({static_cast<uint32_t>(b), 0, 0, 0}, {7, 0}))) {
+      ASSERT_TRUE(std::isfinite(z));
+      sum += z;
+      sum_sq += z * z;
+    }
+  }
+  const double n = 4.0 * blocks;
+  EXPECT_NEAR(sum / n, 0.0, 0.01);
+  EXPECT_NEAR(sum_sq / n, 1.0, 0.01);
+  EXPECT_GT(UniformOpen(0), 0.0);
+  EXPECT_LT(UniformOpen(0xffffffff), 1.0);
+}
+
+}  // namespace lvt
@@ -0,0 +1,36 @@
+#include "gtest/gtest.h"
+#include "util/running_stats.h"
+#include <vector>
+
+namespace lvt {
+
+TEST(RunningStatsTest, MatchesTwoPassMoments) {
+  std::vector<double> xs = {2, 4, 4, 4, 5, 5, 7, 9};
+  RunningStats stats;
+  for (double x : xs) stats.Add(x);
+  EXPECT_EQ(stats.count(), 8);
+  EXPECT_DOUBLE_EQ(stats.mean(), 5.0);
+  EXPECT_DOUBLE_EQ(stats.variance(), 4.0);
+  EXPECT_DOUBLE_EQ(stats.stddev(), 2.0);
+  EXPECT_DOUBLE_EQ(RunningStats().variance(), 0.0);
+}
+
+TEST(RunningStatsTest, StableForLargeOffsets) {
+  // Naive sum-of-squares loses every digit here.
+  RunningStats stats;
+  for (double x : {1e9 + 4, 1e9 + 7, 1e9 + 13, 1e9 + 16}) stats.Add(x);
+  EXPECT_DOUBLE_EQ(stats.variance(), 22.5);
+}
+
+TEST(RunningCovarianceTest, MatchesTwoPassCovariance) {
+  RunningCovariance cov;
+  cov.Add(1, 2);
+  cov.Add(2, 4);
+  cov.Add(3, 3);
+  cov.Add(4, 7);
+  // Means 2.5 and 4; products of deviations 3, 0, -0.5, 4.5.
+  EXPECT_DOUBLE_EQ(cov.covariance(), 1.75);
+  EXPECT_EQ(cov.count(), 4);
+}
+
+}  // namespace lvt
@@ -0,0 +1,139 @@
+#include "gtest/gtest.h"
+#include "engine/schedule_writer.h"
+#include "market/timestamp.h"
+#include "util/background_writer.h"
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace lvt {
+
+namespace {
+
+std::string ReadFile(const std::filesystem::path& path) {
+  std::ifstream file(path, std::ios::binary);
+  std::stringstream ss;
+  ss << file.rdbuf();
+  return ss.str();
+}
+
+}  // namespace
+
+TEST(ScheduleWriterTest, CsvMatchesStreamFormatting) {
+  const std::vector<int64_t> epoch_ns = {1732458600000000000, 1732458660000000000, 1732458720000000000,
+                                         1732458780000000000, 1732458840000000000, 1732458900000000000};
+  const std::vector<double> volume = {0.1 + 0.2, 1e6, 1234567.0, -2.5e-7, 0.0, 273.17};
+  std::ostringstream expected;
+  expected << "timestamp,trade_volume\n";
+  for (size_t i = 0; i < volume.size(); ++i) {
+    expected << FormatTimestamp(epoch_ns[i]) << "," << volume[i] << "\n";
+  }
+  expected << "interval,trade_volume\n";
+  for (size_t i = 0; i < volume.size(); ++i) expected << i << "," << volume[i] << "\n";
+
+  std::ostringstream out;
+  ScheduleWriter writer;
+  writer.Open(&out);
+  writer.BeginTimestampSchedule();
+  writer.AppendTimestampSchedule(epoch_ns, volume);
+  // Interval numbers continue across appends.
+  writer.BeginIntervalSchedule();
+  writer.AppendIntervalSchedule(std::span<const double>(volume).first(2));
+  writer.AppendIntervalSchedule(std::span<const double>(volume).subspan(2));
+  EXPECT_TRUE(writer.Finish());
+  EXPECT_EQ(out.str(), expected.str());
+  EXPECT_EQ(writer.bytes_written(), out.str().size());
+}
+
+TEST(ScheduleWriterTest, WritesExecutionsAsCsvAndBinary) {
+  const std::vector<ExecutionRecord> executions = {{1, 12.5, 273.17, 1732458600000000000},
+                                                   {2, 0.1 + 0.2, 100.0, 1732458660000000000}};
+  std::ostringstream csv;
+  ScheduleWriter csv_writer;
+  csv_writer.Open(&csv);
+  csv_writer.BeginExecutions();
+  csv_writer.AppendExecutions(executions);
+  EXPECT_TRUE(csv_writer.Finish());
+  EXPECT_EQ(csv.str(),
+            "order_id,timestamp,quantity,price\n"
+            "1,2024-11-24 14:30:00+00:00,12.5,273.17\n"
+            "2,2024-11-24 14:31:00+00:00,0.3,100\n");
+
+  const auto path = std::filesystem::temp_directory_path() / "lvt_schedule_writer_executions.lvts";
+  ScheduleWriter writer(OutputFormat::kBinary);
+  ASSERT_TRUE(writer.Open(path.string()));
+  writer.BeginExecutions();
+  writer.AppendExecutions(executions);
+  ASSERT_TRUE(writer.Finish());
+  EXPECT_EQ(std::filesystem::file_size(path), sizeof(BinaryOutputHeader) + 2 * sizeof(ExecutionRecord));
+  std::vector<ExecutionRecord> read;
+  ASSERT_TRUE(ReadBinaryExecutions(path.string(), &read));
+  ASSERT_EQ(read.size(), 2u);
+  EXPECT_EQ(read[1].order_id, 2);
+  EXPECT_EQ(read[1].quantity, 0.1 + 0.2);  // Binary output keeps every bit.
+  EXPECT_EQ(read[1].epoch_ns, 1732458660000000000);
+  std::vector<ScheduleRecord> rows;
+  OutputKind kind;
+  EXPECT_FALSE(ReadBinarySchedule(path.string(), &kind, &rows));
+  std::filesystem::remove(path);
+}
+
+TEST(ScheduleWriterTest, AsyncOutputMatchesSynchronousOutput) {
+  // Enough rows for several kFlushBytes blocks to be queued.
+  std::vector<double> volume(300000);
+  for (size_t i = 0; i < volume.size(); ++i) volume[i] = 1000.0 / (i + 1);
+  const auto dir = std::filesystem::temp_directory_path();
+  const auto sync_path = dir / "lvt_schedule_writer_sync.csv";
+  const auto async_path = dir / "lvt_schedule_writer_async.csv";
+  const auto binary_path = dir / "lvt_schedule_writer_async.lvts";
+
+  ScheduleWriter sync_writer;
+  ASSERT_TRUE(sync_writer.Open(sync_path.string()));
+  sync_writer.BeginIntervalSchedule();
+  sync_writer.AppendIntervalSchedule(volume);
+  ASSERT_TRUE(sync_writer.Finish());
+  ASSERT_GT(sync_writer.bytes_written(), 3 * ScheduleWriter::kFlushBytes);
+
+  BackgroundWriter background(ScheduleWriter::kFlushBytes * 2);
+  {
+    ScheduleWriter writer(OutputFormat::kCsv, &background);
+    ASSERT_TRUE(writer.Open(async_path.string()));
+    writer.BeginIntervalSchedule();
+    writer.AppendIntervalSchedule(volume);
+    EXPECT_TRUE(writer.Finish());
+    ScheduleWriter binary(OutputFormat::kBinary, &background);
+    ASSERT_TRUE(binary.Open(binary_path.string()));
+    binary.BeginIntervalSchedule();
+    binary.AppendIntervalSchedule(volume);
+    // Finished by the destructor.
+  }
+  ASSERT_TRUE(background.Drain());
+  EXPECT_EQ(ReadFile(async_path), ReadFile(sync_path));
+
+  std::vector<ScheduleRecord> rows;
+  OutputKind kind;
+  ASSERT_TRUE(ReadBinarySchedule(binary_path.string(), &kind, &rows));
+  EXPECT_EQ(kind, OutputKind::kIntervalSchedule);
+  ASSERT_EQ(rows.size(), volume.size());
+  EXPECT_EQ(rows.back().key, static_cast<int64_t>(volume.size() - 1));
+  EXPECT_EQ(rows.back().trade_volume, volume.back());
+  std::filesystem::remove(sync_path);
+  std::filesystem::remove(async_path);
+  std::filesystem::remove(binary_path);
+}
+
+TEST(ScheduleWriterTest, ParsesOutputFormat) {
+  OutputFormat format = OutputFormat::kCsv;
+  EXPECT_TRUE(ParseOutputFormat("binary", &format));
+  EXPECT_EQ(format, OutputFormat::kBinary);
+  EXPECT_STREQ(OutputExtension(format), ".lvts");
+  EXPECT_TRUE(ParseOutputFormat("csv", &format));
+  EXPECT_EQ(format, OutputFormat::kCsv);
+  EXPECT_FALSE(ParseOutputFormat("parquet", &format));
+  ScheduleWriter writer;
+  EXPECT_FALSE(writer.Open("/nonexistent_dir/out.csv"));
+}
+
+}  // namespace lvt
@@ -0,0 +1,102 @@
+#include "gtest/gtest.h"
+#include "market/synthetic_market_data.h"
+#include "market/timestamp.h"
+#include <cmath>
+#include <vector>
+
+namespace lvt {
+
+namespace {
+
+MarketDataColumns GenerateAll(const SyntheticMarketConfig& config, uint32_t stream,
+                              size_t batch_size = SyntheticMarketGenerator::kDefaultBatchSize) {
+  MarketDataColumns all;
+  SyntheticMarketGenerator generator(config, stream);
+  EXPECT_TRUE(generator.Generate(
+      [&all](MarketDataView batch) {
+        for (size_t i = 0; i < batch.size(); ++i) all.Append(batch.Row(i));
+        return true;
+      },
+      batch_size));
+  EXPECT_EQ(all.size(), generator.row_count());
+  return all;
+}
+
+}  // namespace
+
+TEST(SyntheticMarketDataTest, SessionsSkipWeekends) {
+  SyntheticMarketConfig config;
+  config.days = 6;  // Monday 2025-01-06 to Monday 2025-01-13.
+  MarketDataColumns bars = GenerateAll(config, 0);
+  ASSERT_EQ(bars.size(), 6 * 390);
+  EXPECT_EQ(FormatTimestamp(bars.epoch_ns()[0]), "2025-01-06 14:30:00+00:00");
+  EXPECT_EQ(FormatTimestamp(bars.epoch_ns()[389]), "2025-01-06 20:59:00+00:00");
+  EXPECT_EQ(FormatTimestamp(bars.epoch_ns()[5 * 390]), "2025-01-13 14:30:00+00:00");
+  for (size_t i = 1; i < bars.size(); ++i) ASSERT_GT(bars.epoch_ns()[i], bars.epoch_ns()[i - 1]);
+}
+
+TEST(SyntheticMarketDataTest, DeterministicPerSeedAndStream) {
+  SyntheticMarketConfig config;
+  config.days = 3;
+  MarketDataColumns a = GenerateAll(config, 5);
+  MarketDataColumns b = GenerateAll(config, 5, 7);  // Batching does not matter.
+  MarketDataColumns other = GenerateAll(config, 6);
+  ASSERT_EQ(a.size(), b.size());
+  for (size_t i = 0; i < a.size(); ++i) {
+    ASSERT_EQ(a.price()[i], b.price()[i]);
+    ASSERT_EQ(a.volume()[i], b.volume()[i]);
+  }
+  EXPECT_NE(a.price()[100], other.price()[100]);
+  config.seed = 2;
+  EXPECT_NE(GenerateAll(config, 5).price()[100], a.price()[100]);
+}
+
+TEST(SyntheticMarketDataTest, VolumeCurveIsUShapedAndHitsDailyVolume) {
+  SyntheticMarketConfig config;
+  config.days = 200;
+  MarketDataColumns bars = GenerateAll(config, 1);
+  std::vector<double> by_minute(390, 0.0);
+  double total = 0.0;
+  for (size_t i = 0; i < bars.size(); ++i) {
+    by_minute[i % 390] += bars.volume()[i];
+    total += bars.volume()[i];
+    ASSERT_EQ(bars.volume()[i], std::round(bars.volume()[i]));
+  }
+  EXPECT_NEAR(total / config.days / config.daily_volume, 1.0, 0.01);
+  // Open and close trade about 1 + u_shape times the midday rate.
+  EXPECT_NEAR(by_minute[0] / by_minute[195], 4.0, 0.4);
+  EXPECT_NEAR(by_minute[389] / by_minute[195], 4.0, 0.4);
+}
+
+TEST(SyntheticMarketDataTest, PricesFollowConfiguredVolatilityOnTickGrid) {
+  SyntheticMarketConfig config;
+  config.days = 100;
+  config.volatility = 0.4;
+  config.tick_size = 0;  // Rounding would add bid-ask style noise.
+  MarketDataColumns bars = GenerateAll(config, 2);
+  double sum = 0.0, sum_sq = 0.0;
+  for (size_t i = 1; i < bars.size(); ++i) {
+    const double r = std::log(bars.price()[i] / bars.price()[i - 1]);
+    sum += r;
+    sum_sq += r * r;
+  }
+  const double n = bars.size() - 1;
+  const double annualized = std::sqrt((sum_sq / n - (sum / n) * (sum / n)) * 252 * 390);
+  EXPECT_NEAR(annualized, 0.4, 0.01);
+
+  config.tick_size = 0.05;
+  config.days = 1;
+  bars = GenerateAll(config, 2);
+  for (double p : bars.price()) EXPECT_NEAR(p * 20, std::round(p * 20), 1e-9);
+}
+
+TEST(SyntheticMarketDataTest, SinkCanStopGeneration) {
+  SyntheticMarketConfig config;
+  config.days = 10;
+  SyntheticMarketGenerator generator(config, 0);
+  size_t batches = 0;
+  EXPECT_FALSE(generator.Generate([&batches](MarketDataView) { return ++batches < 3; }, 100));
+  EXPECT_EQ(batches, 3);
+}
+
+}  // namespace lvt
@@ -0,0 +1,59 @@
+#include "gtest/gtest.h"
+#include "util/thread_pool.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace lvt {
+
+TEST(ThreadPoolTest, ParallelForVisitsEveryIndexOnce) {
+  ThreadPool pool(4);
+  std::vector<std::atomic<int>> hits(1000);
+  pool.ParallelFor(hits.size(), [&](size_t i) { hits[i]++; });
+  for (const auto& h : hits) EXPECT_EQ(h.load(), 1);
+}
+
+TEST(ThreadPoolTest, NestedParallelForDoesNotDeadlock) {
+  ThreadPool pool(2);
+  std::atomic<int> total{0};
+  pool.ParallelFor(8, [&](size_t) {
+    pool.ParallelFor(8, [&](size_t) { total++; });
+  });
+  EXPECT_EQ(total.load(), 64);
+}
+
+TEST(ThreadPoolTest, SubmittedTasksRunBeforeDestruction) {
+  std::atomic<int> ran{0};
+  {
+    ThreadPool pool(3);
+    for (int i = 0; i < 50; ++i) pool.Submit([&] { ran++; });
+  }
+  EXPECT_EQ(ran.load(), 50);
+}
+
+TEST(ThreadPoolTest, IdleWorkersStealTasksSubmittedByAWorker) {
+  ThreadPool pool(4);
+  std::atomic<int> running{0};
+  std::atomic<int> saw_all{0};
+  std::atomic<int> finished{0};
+  // All four tasks land in one worker's deque; they can only run at the
+  // same time if the other workers steal them.
+  pool.Submit([&] {
+    for (int i = 0; i < 4; ++i) {
+      pool.Submit([&] {
+        running++;
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (running.load() < 4 && std::chrono::steady_clock::now() < deadline) {
+          std::this_thread::yield();
+        }
+        if (running.load() == 4) saw_all++;
+        finished++;
+      });
+    }
+  });
+  while (finished.load() < 4) std::this_thread::yield();
+  EXPECT_EQ(saw_all.load(), 4);
+}
+
+}  // namespace lvt
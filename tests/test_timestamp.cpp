@@ -0,0 +1,78 @@
+#include "gtest/gtest.h"
+#include "market/timestamp.h"
+#include <limits>
+
+namespace lvt {
+
+TEST(TimestampTest, ParsesIsoWithOffset) {
+  int64_t epoch_ns = 0;
+  ASSERT_TRUE(ParseTimestamp("2025-11-24 14:30:00+00:00", &epoch_ns));
+  EXPECT_EQ(epoch_ns, 1763994600LL * kNanosPerSecond);
+  ASSERT_TRUE(ParseTimestamp("2025-11-24T16:30:00+02:00", &epoch_ns));
+  EXPECT_EQ(epoch_ns, 1763994600LL * kNanosPerSecond);
+  ASSERT_TRUE(ParseTimestamp("1970-01-01", &epoch_ns));
+  EXPECT_EQ(epoch_ns, 0);
+}
+
+TEST(TimestampTest, ParsesFractionalSeconds) {
+  int64_t epoch_ns = 0;
+  ASSERT_TRUE(ParseTimestamp("1970-01-01 00:00:01.25Z", &epoch_ns));
+  EXPECT_EQ(epoch_ns, 1250000000LL);
+}
+
+TEST(TimestampTest, RejectsMalformedText) {
+  int64_t epoch_ns = 0;
+  EXPECT_FALSE(ParseTimestamp("", &epoch_ns));
+  EXPECT_FALSE(ParseTimestamp("t0", &epoch_ns));
+  EXPECT_FALSE(ParseTimestamp("2025-13-01 00:00:00", &epoch_ns));
+  // Days past the end of the month, with leap years.
+  EXPECT_FALSE(ParseTimestamp("2025-02-31", &epoch_ns));
+  EXPECT_FALSE(ParseTimestamp("2025-02-29 00:00:00", &epoch_ns));
+  EXPECT_FALSE(ParseTimestamp("1900-02-29", &epoch_ns));
+  EXPECT_FALSE(ParseTimestamp("2025-04-31", &epoch_ns));
+  EXPECT_TRUE(ParseTimestamp("2024-02-29", &epoch_ns));
+  EXPECT_TRUE(ParseTimestamp("2000-02-29", &epoch_ns));
+  EXPECT_TRUE(ParseTimestamp("2025-12-31", &epoch_ns));
+  // Offsets beyond +-14:00 or with 60+ minutes.
+  EXPECT_FALSE(ParseTimestamp("2025-11-24 14:30:00+99:99", &epoch_ns));
+  EXPECT_FALSE(ParseTimestamp("2025-11-24 14:30:00+15:00", &epoch_ns));
+  EXPECT_FALSE(ParseTimestamp("2025-11-24 14:30:00-14:01", &epoch_ns));
+  EXPECT_FALSE(ParseTimestamp("2025-11-24 14:30:00+05:60", &epoch_ns));
+  EXPECT_TRUE(ParseTimestamp("2025-11-24 14:30:00+14:00", &epoch_ns));
+  EXPECT_TRUE(ParseTimestamp("2025-11-24 14:30:00-12:00", &epoch_ns));
+  EXPECT_TRUE(ParseTimestamp("2025-11-24 14:30:00+05", &epoch_ns));
+  EXPECT_TRUE(ParseTimestamp("2025-11-24 14:30:00+0530", &epoch_ns));
+  EXPECT_FALSE(ParseTimestamp("2025-11-24 14:30:00+05:", &epoch_ns));
+  // Outside the int64 nanosecond range (1677-09-21 to 2262-04-11).
+  EXPECT_FALSE(ParseTimestamp("0001-01-01T00:00:00", &epoch_ns));
+  EXPECT_FALSE(ParseTimestamp("9999-12-31 23:59:59", &epoch_ns));
+  EXPECT_FALSE(ParseTimestamp("2262-04-11 23:47:17", &epoch_ns));
+  EXPECT_TRUE(ParseTimestamp("2262-04-11 23:47:16.854775807", &epoch_ns));
+  EXPECT_EQ(epoch_ns, std::numeric_limits<int64_t>::max());
+  EXPECT_TRUE(ParseTimestamp("1677-09-21 00:12:44", &epoch_ns));
+  EXPECT_FALSE(ParseTimestamp("2025-11-24 14:30:00 junk", &epoch_ns));
+}
+
+TEST(TimestampTest, FormatRoundTrips) {
+  for (const char* text : {"2025-11-24 14:30:00+00:00", "1969-12-31 23:59:59+00:00",
+                           "2000-02-29 12:00:00.5+00:00"}) {
+    int64_t epoch_ns = 0;
+    ASSERT_TRUE(ParseTimestamp(text, &epoch_ns));
+    EXPECT_EQ(FormatTimestamp(epoch_ns), text);
+  }
+}
+
+TEST(TimestampTest, EpochDayFloorsNegativeTimes) {
+  EXPECT_EQ(EpochDay(0), 0);
+  EXPECT_EQ(EpochDay(kNanosPerDay - 1), 0);
+  EXPECT_EQ(EpochDay(-1), -1);
+}
+
+TEST(TimestampTest, FloorToMinuteRoundsDown) {
+  EXPECT_EQ(FloorToMinute(kNanosPerMinute + 5), kNanosPerMinute);
+  EXPECT_EQ(FloorToMinute(kNanosPerMinute), kNanosPerMinute);
+  EXPECT_EQ(FloorToMinute(-1), -kNanosPerMinute);
+  EXPECT_EQ(FloorToMinute(-kNanosPerMinute), -kNanosPerMinute);
+}
+
+}  // namespace lvt
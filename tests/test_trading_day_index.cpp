@@ -0,0 +1,38 @@
+#include "gtest/gtest.h"
+#include "market/timestamp.h"
+#include "market/trading_day_index.h"
+#include <vector>
+
+namespace lvt {
+
+TEST(TradingDayIndexTest, SplitsBarsByUtcDay) {
+  const int64_t day0 = 20000 * kNanosPerDay;
+  std::vector<int64_t> epoch_ns = {day0 + 1, day0 + 2, day0 + kNanosPerDay,
+                                   day0 + 3 * kNanosPerDay, day0 + 3 * kNanosPerDay + 5};
+  TradingDayIndex index;
+  ASSERT_TRUE(index.Build(epoch_ns));
+  ASSERT_EQ(index.day_count(), 3);
+  EXPECT_EQ(index.day(0), 20000);
+  EXPECT_EQ(index.day(2), 20003);
+  EXPECT_EQ(index.begin(0), 0);
+  EXPECT_EQ(index.end(0), 2);
+  EXPECT_EQ(index.begin(1), 2);
+  EXPECT_EQ(index.end(2), 5);
+  EXPECT_EQ(index.Find(20003), 2);
+  EXPECT_EQ(index.Find(20002), TradingDayIndex::kNotFound);
+}
+
+TEST(TradingDayIndexTest, RejectsUnsortedTimestamps) {
+  std::vector<int64_t> epoch_ns = {kNanosPerDay, 0};
+  TradingDayIndex index;
+  EXPECT_FALSE(index.Build(epoch_ns));
+  EXPECT_EQ(index.day_count(), 0);
+}
+
+TEST(TradingDayIndexTest, EmptyInput) {
+  TradingDayIndex index;
+  ASSERT_TRUE(index.Build({}));
+  EXPECT_EQ(index.day_count(), 0);
+}
+
+}  // namespace lvt
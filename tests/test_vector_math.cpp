@@ -0,0 +1,21 @@
+#include "gtest/gtest.h"
+#include "util/vector_math.h"
+#include <cmath>
+
+namespace lvt {
+
+TEST(VectorMathTest, FastExpMatchesStdExp) {
+  for (double x = -700.0; x <= 700.0; x += 0.37) {
+    const double expected = std::exp(x);
+    EXPECT_NEAR(FastExp(x), expected, 4e-16 * expected) << "x=" << x;
+  }
+  EXPECT_EQ(FastExp(0.0), 1.0);
+}
+
+TEST(VectorMathTest, FastExpClampsOutOfRangeArguments) {
+  EXPECT_LT(FastExp(-1e6), 1e-300);
+  EXPECT_GE(FastExp(-1e6), 0.0);
+  EXPECT_TRUE(std::isfinite(FastExp(1e6)));
+}
+
+}  // namespace lvt
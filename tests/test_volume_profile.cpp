@@ -0,0 +1,95 @@
+#include "gtest/gtest.h"
+#include "market/timestamp.h"
+#include "market/trading_day_index.h"
+#include "market/volume_profile.h"
+#include "util/thread_pool.h"
+#include <filesystem>
+#include <fstream>
+
+namespace lvt {
+
+namespace {
+
+// `days` sessions; day d has a bar at minutes 570..579 with volume (d + 1) * minute.
+MarketDataColumns MakeHistory(int days) {
+  MarketDataColumns data;
+  for (int64_t d = 0; d < days; ++d) {
+    for (int64_t m = 570; m < 580; ++m) {
+      data.Append(d * kNanosPerDay + m * kNanosPerMinute, 100.0, static_cast<double>((d + 1) * m));
+    }
+  }
+  return data;
+}
+
+}  // namespace
+
+TEST(VolumeProfileTest, AveragesVolumeByMinuteOfDay) {
+  MarketDataColumns data = MakeHistory(4);
+  // A bar on day 0 only: the other days count as zero volume for that minute.
+  MarketDataColumns extra = {{100 * kNanosPerMinute, 1.0, 40.0}};
+  MarketDataColumns all;
+  all.Append(extra.Row(0));
+  for (size_t i = 0; i < data.size(); ++i) all.Append(data.Row(i));
+  TradingDayIndex days;
+  ASSERT_TRUE(days.Build(all.epoch_ns()));
+
+  VolumeProfile profile;
+  ASSERT_TRUE(profile.Build(all, days));
+  EXPECT_EQ(profile.day_count(), 4);
+  EXPECT_EQ(profile.first_day(), 0);
+  EXPECT_EQ(profile.last_day(), 3);
+  ASSERT_EQ(profile.average_volume().size(), VolumeProfile::kMinutesPerDay);
+  EXPECT_DOUBLE_EQ(profile.average_volume()[570], 570.0 * (1 + 2 + 3 + 4) / 4);
+  EXPECT_DOUBLE_EQ(profile.average_volume()[100], 10.0);
+  EXPECT_DOUBLE_EQ(profile.average_volume()[0], 0.0);
+  EXPECT_DOUBLE_EQ(profile.ExpectedVolume(9 * kNanosPerDay + 575 * kNanosPerMinute + 59), 575.0 * 2.5);
+}
+
+TEST(VolumeProfileTest, ParallelBuildMatchesSerial) {
+  MarketDataColumns data = MakeHistory(37);
+  TradingDayIndex days;
+  ASSERT_TRUE(days.Build(data.epoch_ns()));
+  VolumeProfile serial, parallel;
+  ASSERT_TRUE(serial.Build(data, days));
+  ThreadPool pool(4);
+  ASSERT_TRUE(parallel.Build(data, days, &pool));
+  for (size_t m = 0; m < VolumeProfile::kMinutesPerDay; ++m) {
+    EXPECT_NEAR(parallel.average_volume()[m], serial.average_volume()[m], 1e-9) << m;
+  }
+}
+
+TEST(VolumeProfileTest, SaveAndLoadRoundTrip) {
+  MarketDataColumns data = MakeHistory(3);
+  TradingDayIndex days;
+  ASSERT_TRUE(days.Build(data.epoch_ns()));
+  VolumeProfile profile;
+  ASSERT_TRUE(profile.Build(data, days));
+  const auto path = std::filesystem::temp_directory_path() / "lvt_volume_profile.lvtp";
+  ASSERT_TRUE(profile.Save(path.string()));
+
+  VolumeProfile loaded;
+  ASSERT_TRUE(loaded.Load(path.string()));
+  EXPECT_EQ(loaded.day_count(), 3);
+  EXPECT_EQ(loaded.last_day(), 2);
+  for (size_t m = 0; m < VolumeProfile::kMinutesPerDay; ++m) {
+    EXPECT_EQ(loaded.average_volume()[m], profile.average_volume()[m]);
+  }
+
+  { std::ofstream(path, std::ios::binary) << "not a profile"; }
+  EXPECT_FALSE(loaded.Load(path.string()));
+  EXPECT_EQ(loaded.day_count(), 3);  // Unchanged on failure
+  std::filesystem::remove(path);
+  EXPECT_FALSE(loaded.Load(path.string()));
+}
+
+TEST(VolumeProfileTest, EmptyInputIsRejected) {
+  MarketDataColumns data;
+  TradingDayIndex days;
+  days.Build(data.epoch_ns());
+  VolumeProfile profile;
+  EXPECT_FALSE(profile.Build(data, days));
+  EXPECT_TRUE(profile.empty());
+  EXPECT_FALSE(profile.Save("/tmp/lvt_never_written.lvtp"));
+}
+
+}  // namespace lvt
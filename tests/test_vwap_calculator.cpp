@@ -1,6 +1,9 @@
 #include "gtest/gtest.h"
 #include "strategy/vwap_calculator.h"
-#include "market/market_simulator.h"
+#include "market/market_data_columns.h"
+#include "market/timestamp.h"
+#include "market/trading_day_index.h"
+#include "market/volume_profile.h"
 
 namespace lvt {
 
@@ -17,7 +20,8 @@ TEST(VWAPCalculatorTest, EmptyMarketData) {
 // Purpose: No order to execute means nothing to schedule.
 TEST(VWAPCalculatorTest, ZeroTotalVolume) {
   VWAPCalculator calc;
-  calc.SetMarketData({{"t0", 100, 10}});
+  MarketDataColumns d = {{0, 100, 10}};
+  calc.SetMarketData(d);
   calc.ComputeVWAPSchedule(0.0);
   EXPECT_TRUE(calc.GetSchedule().empty());
 }
@@ -26,8 +30,8 @@ TEST(VWAPCalculatorTest, ZeroTotalVolume) {
 // Purpose: No liquidity means no proportional allocation.
 TEST(VWAPCalculatorTest, AllMarketVolumesZero) {
   VWAPCalculator calc;
-  std::vector<MarketData> d = {
-      {"t0", 100, 0},{"t1", 200, 0}};
+  MarketDataColumns d = {
+      {0, 100, 0},{1, 200, 0}};
   calc.SetMarketData(d);
   calc.ComputeVWAPSchedule(50);
   EXPECT_TRUE(calc.GetSchedule().empty());
@@ -37,7 +41,7 @@ TEST(VWAPCalculatorTest, AllMarketVolumesZero) {
 // Purpose: All volume should be assigned to that interval.
 TEST(VWAPCalculatorTest, SingleIntervalAllVolume) {
   VWAPCalculator calc;
-  std::vector<MarketData> d = {{"t0", 99.9, 25}};
+  MarketDataColumns d = {{0, 99.9, 25}};
   calc.SetMarketData(d);
   calc.ComputeVWAPSchedule(100);
   const auto& sched = calc.GetSchedule();
@@ -49,11 +53,11 @@ TEST(VWAPCalculatorTest, SingleIntervalAllVolume) {
 // Purpose: Volume split evenly across intervals.
 TEST(VWAPCalculatorTest, EvenDistribution) {
   VWAPCalculator calc;
-  std::vector<MarketData> d = {
-      {"t0", 10, 10},
-      {"t1", 15, 10},
-      {"t2", 20, 10},
-      {"t3", 25, 10}};
+  MarketDataColumns d = {
+      {0, 10, 10},
+      {1, 15, 10},
+      {2, 20, 10},
+      {3, 25, 10}};
   calc.SetMarketData(d);
   calc.ComputeVWAPSchedule(40);
   auto sched = calc.GetSchedule();
@@ -65,10 +69,10 @@ TEST(VWAPCalculatorTest, EvenDistribution) {
 // Purpose: Each successive interval gets more of the total.
 TEST(VWAPCalculatorTest, IncreasingVolume) {
   VWAPCalculator calc;
-  std::vector<MarketData> d = {
-      {"t0", 11, 10},
-      {"t1", 12, 20},
-      {"t2", 13, 30}}
+  MarketDataColumns d = {
+      {0, 11, 10},
+      {1, 12, 20},
+      {2, 13, 30}}
   ;
   calc.SetMarketData(d);
   calc.ComputeVWAPSchedule(60);
@@ -83,10 +87,10 @@ TEST(VWAPCalculatorTest, IncreasingVolume) {
 // Purpose: Total volume assigned to the highest-volume interval.
 TEST(VWAPCalculatorTest, OneIntervalDominant) {
   VWAPCalculator calc;
-  std::vector<MarketData> d = {
-      {"t0", 11, 0},
-      {"t1", 11, 0},
-      {"t2", 11, 100}};
+  MarketDataColumns d = {
+      {0, 11, 0},
+      {1, 11, 0},
+      {2, 11, 100}};
   calc.SetMarketData(d);
   calc.ComputeVWAPSchedule(100);
   auto sched = calc.GetSchedule();
@@ -100,9 +104,9 @@ TEST(VWAPCalculatorTest, OneIntervalDominant) {
 // Purpose: Ensure scheduler rejects negative total target volume.
 TEST(VWAPCalculatorTest, NegativeTotalVolume) {
   VWAPCalculator calc;
-  std::vector<MarketData> d = {
-    {"t0", 100, 10},
-    {"t1", 100, 10}};
+  MarketDataColumns d = {
+    {0, 100, 10},
+    {1, 100, 10}};
   calc.SetMarketData(d);
   calc.ComputeVWAPSchedule(-50.0);
   EXPECT_TRUE(calc.GetSchedule().empty());
@@ -111,12 +115,12 @@ TEST(VWAPCalculatorTest, NegativeTotalVolume) {
 // Test 9: Realistic pattern, last period largest (matches sample_market.csv).
 // Purpose: Checks known cases from sample data for regression.
 TEST(VWAPCalculatorTest, MatchesSampleMarket) {
-  std::vector<MarketData> market_data = {
-    {"2025-01-01T09:30:00", 100.0, 10},
-    {"2025-01-01T09:31:00", 100.0, 10},
-    {"2025-01-01T09:32:00", 100.0, 20},
-    {"2025-01-01T09:33:00", 100.0, 20},
-    {"2025-01-01T09:34:00", 100.0, 40},
+  MarketDataColumns market_data = {
+    {1735723800000000000LL, 100.0, 10},
+    {1735723860000000000LL, 100.0, 10},
+    {1735723920000000000LL, 100.0, 20},
+    {1735723980000000000LL, 100.0, 20},
+    {1735724040000000000LL, 100.0, 40},
   };
   VWAPCalculator calc;
   calc.SetMarketData(market_data);
@@ -135,7 +139,8 @@ TEST(VWAPCalculatorTest, MatchesSampleMarket) {
 TEST(VWAPCalculatorTest, ScheduleSizeMatchesMarketData) {
   VWAPCalculator calc;
   for (int sz = 0; sz < 5; ++sz) {
-    std::vector<MarketData> d(sz, {"t", 10, 10});
+    MarketDataColumns d;
+    for (int i = 0; i < sz; ++i) d.Append(i, 10, 10);
     calc.SetMarketData(d);
     calc.ComputeVWAPSchedule(100.0);
     EXPECT_EQ(calc.GetSchedule().size(), d.size());
@@ -146,10 +151,10 @@ TEST(VWAPCalculatorTest, ScheduleSizeMatchesMarketData) {
 // Purpose: If all prices are rising, the VWAP should be below the last (max) price,
 // since early trades are at cheaper prices.
 TEST(VWAPCalculatorTest, VWAPLowerThanMaxWhenIncreasing) {
-  std::vector<MarketData> d = {
-    {"t0", 10, 10},
-    {"t1", 20, 10},
-    {"t2", 30, 10}
+  MarketDataColumns d = {
+    {0, 10, 10},
+    {1, 20, 10},
+    {2, 30, 10}
   };
   VWAPCalculator calc;
   calc.SetMarketData(d);
@@ -158,7 +163,7 @@ TEST(VWAPCalculatorTest, VWAPLowerThanMaxWhenIncreasing) {
   // Realized VWAP = sum(price * amount) / total volume
   double vwap = 0;
   for (size_t i = 0; i < sched.size(); ++i) {
-    vwap += d[i].price * sched[i];
+    vwap += d.price()[i] * sched[i];
   }
   vwap /= 30.0;
   double max_price = 30.0;
@@ -169,10 +174,10 @@ TEST(VWAPCalculatorTest, VWAPLowerThanMaxWhenIncreasing) {
 // Purpose: If all prices are falling, the VWAP will be above the last (min) price,
 // since more trades occurred at the higher early prices.
 TEST(VWAPCalculatorTest, VWAPHigherThanMinWhenDecreasing) {
-  std::vector<MarketData> d = {
-    {"t0", 30, 10},
-    {"t1", 20, 10},
-    {"t2", 10, 10}
+  MarketDataColumns d = {
+    {0, 30, 10},
+    {1, 20, 10},
+    {2, 10, 10}
   };
   VWAPCalculator calc;
   calc.SetMarketData(d);
@@ -180,11 +185,43 @@ TEST(VWAPCalculatorTest, VWAPHigherThanMinWhenDecreasing) {
   auto sched = calc.GetSchedule();
   double vwap = 0;
   for (size_t i = 0; i < sched.size(); ++i) {
-    vwap += d[i].price * sched[i];
+    vwap += d.price()[i] * sched[i];
   }
   vwap /= 30.0;
   double min_price = 10.0;
   EXPECT_GT(vwap, min_price);
 }
 
+// Test 13: Forward-looking schedule from a historical volume profile.
+// Purpose: A future session is weighted by the average volume of each minute
+// of day, and an unaligned start is rounded down to the minute.
+TEST(VWAPCalculatorTest, ProfileScheduleWeightsFutureSessionByHistory) {
+  // Two historical days with bars at minutes 0, 1 and 2 of the day.
+  MarketDataColumns history;
+  for (int64_t day : {0, 1}) {
+    for (int64_t m = 0; m < 3; ++m) {
+      history.Append(day * kNanosPerDay + m * kNanosPerMinute, 100.0, 10.0 * (m + 1) * (day + 1));
+    }
+  }
+  TradingDayIndex days;
+  ASSERT_TRUE(days.Build(history.epoch_ns()));
+  VolumeProfile profile;
+  ASSERT_TRUE(profile.Build(history, days));
+
+  VWAPCalculator calc;
+  const int64_t session = 5 * kNanosPerDay;
+  calc.ComputeProfileSchedule(profile, session + 7, session + 3 * kNanosPerMinute, 600);
+  const auto& sched = calc.GetSchedule();
+  ASSERT_EQ(sched.size(), 3);
+  // Average volumes 15, 30, 45 per minute.
+  EXPECT_DOUBLE_EQ(sched[0], 100);
+  EXPECT_DOUBLE_EQ(sched[1], 200);
+  EXPECT_DOUBLE_EQ(sched[2], 300);
+
+  calc.ComputeProfileSchedule(profile, session + 10 * kNanosPerMinute, session + 20 * kNanosPerMinute, 600);
+  EXPECT_TRUE(calc.GetSchedule().empty());  // No historical volume in the window
+  calc.ComputeProfileSchedule(VolumeProfile(), session, session + kNanosPerMinute, 600);
+  EXPECT_TRUE(calc.GetSchedule().empty());
+}
+
 }  // namespace lvt